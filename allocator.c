@@ -0,0 +1,439 @@
+/**
+ * allocator.c
+ *
+ * Implementation of functions for the allocator module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <stdalign.h>
+#include "allocator_p.h"
+
+// The default size of an arena block
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/*
+A block of memory for the arena or the pool.
+Memory is handed out from data by bumping used.
+Blocks are chained through next so they can all be freed together
+*/
+typedef struct _block
+{
+  struct _block *next;
+  size_t size; // bytes available in data
+  size_t used; // bytes handed out from data
+  alignas(max_align_t) char data[];
+} *_block_p;
+
+/*
+The arena data type for the allocator module.
+New allocations come from the first block in the chain
+*/
+typedef struct arena
+{
+  _block_p blocks;
+  size_t block_size;
+} *arena_p;
+
+/*
+The pool data type for the allocator module.
+Freed objects are kept on a free list (the first bytes of each free
+object point to the next free object)
+*/
+typedef struct pool
+{
+  _block_p slabs;
+  void *free_list;
+  size_t requested_size; // the object size the pool was created with
+  size_t object_size;    // the aligned size of each object in a slab
+  int objects_per_slab;
+} *pool_p;
+
+/*
+Gets the default allocator, which uses malloc, realloc and free
+
+Returns:
+  The default allocator
+
+*/
+allocator allocator_default(void)
+{
+  allocator alloc = {_malloc_alloc, _malloc_realloc, _malloc_free, NULL};
+  return alloc;
+}
+
+/*
+Creates and initialises a new, empty bump arena
+
+Inputs:
+  block_size - the size of each block (0 for DEFAULT_BLOCK_SIZE)
+
+Returns:
+  An arena_p (pointer to the newly created arena)
+
+Throws:
+  aborts if the memory allocation fails
+
+*/
+arena_p arena_create(size_t block_size)
+{
+  arena_p arena;
+  arena = (arena_p)malloc(sizeof(struct arena));
+  assert(arena != NULL && "Error in memory allocation");
+
+  arena->blocks = NULL;
+  arena->block_size = block_size > 0 ? _align_size(block_size) : DEFAULT_BLOCK_SIZE;
+  return arena;
+}
+
+/*
+Gets an allocator which allocates from the arena
+
+Inputs:
+  arena - pointer to an instance of the arena type
+
+Returns:
+  The allocator
+
+*/
+allocator arena_allocator(arena_p arena)
+{
+  allocator alloc = {_arena_alloc, _arena_realloc, _arena_free, arena};
+  return alloc;
+}
+
+/*
+Releases all memory allocated from the arena.
+One block is kept (if there is one of the standard size) so that
+an arena which is reset after every request does not go back to malloc
+
+Inputs:
+  arena - pointer to an instance of the arena type
+
+Returns:
+  Nothing
+
+*/
+void arena_reset(arena_p arena)
+{
+  _block_p keep = NULL;
+  _block_p block = arena->blocks;
+  while (block)
+  {
+    _block_p next = block->next;
+    if (keep == NULL && block->size == arena->block_size)
+    {
+      keep = block;
+      keep->next = NULL;
+      keep->used = 0;
+    }
+    else
+    {
+      free(block);
+    }
+    block = next;
+  }
+  arena->blocks = keep;
+}
+
+/*
+Frees the arena and all memory allocated from it
+
+Inputs:
+  arena - pointer to an instance of the arena type
+
+Returns:
+  Nothing
+
+*/
+void arena_delete(arena_p arena)
+{
+  if (arena)
+  {
+    _block_p block = arena->blocks;
+    while (block)
+    {
+      _block_p next = block->next;
+      free(block);
+      block = next;
+    }
+    free(arena);
+  }
+}
+
+/*
+Creates and initialises a new, empty slab pool
+
+Inputs:
+  object_size - the size of each object
+  objects_per_slab - the number of objects in each slab
+
+Returns:
+  A pool_p (pointer to the newly created pool)
+
+Throws:
+  aborts if objects_per_slab is not positive or if the memory allocation fails
+
+*/
+pool_p pool_create(size_t object_size, int objects_per_slab)
+{
+  assert(objects_per_slab > 0 && "Error: A slab must hold at least one object");
+
+  pool_p pool;
+  pool = (pool_p)malloc(sizeof(struct pool));
+  assert(pool != NULL && "Error in memory allocation");
+
+  // A free object must be able to hold the free list pointer
+  size_t size = object_size > sizeof(void *) ? object_size : sizeof(void *);
+  pool->slabs = NULL;
+  pool->free_list = NULL;
+  pool->requested_size = object_size;
+  pool->object_size = _align_size(size);
+  pool->objects_per_slab = objects_per_slab;
+  return pool;
+}
+
+/*
+Gets an allocator which allocates objects from the pool
+
+Inputs:
+  pool - pointer to an instance of the pool type
+
+Returns:
+  The allocator
+
+*/
+allocator pool_allocator(pool_p pool)
+{
+  allocator alloc = {_pool_alloc, _pool_realloc, _pool_free, pool};
+  return alloc;
+}
+
+/*
+Frees the pool and all of its slabs
+
+Inputs:
+  pool - pointer to an instance of the pool type
+
+Returns:
+  Nothing
+
+*/
+void pool_delete(pool_p pool)
+{
+  if (pool)
+  {
+    _block_p slab = pool->slabs;
+    while (slab)
+    {
+      _block_p next = slab->next;
+      free(slab);
+      slab = next;
+    }
+    free(pool);
+  }
+}
+
+/*
+Internal function to round a size up to the alignment of max_align_t,
+so that every allocation is suitably aligned for any type
+
+Inputs:
+  size - the size in bytes
+
+Returns:
+  The aligned size
+
+*/
+size_t _align_size(size_t size)
+{
+  size_t align = alignof(max_align_t);
+  return (size + align - 1) / align * align;
+}
+
+/*
+Internal function to allocate a new block
+
+Inputs:
+  next - the block to chain after the new block
+  size - the number of bytes available in the new block
+
+Returns:
+  A pointer to the new block
+
+Throws:
+  aborts if the memory allocation fails
+
+*/
+_block_p _block_create(_block_p next, size_t size)
+{
+  _block_p block = (_block_p)malloc(sizeof(struct _block) + size);
+  assert(block != NULL && "Error in memory allocation");
+
+  block->next = next;
+  block->size = size;
+  block->used = 0;
+  return block;
+}
+
+/*
+Internal functions for the default allocator
+*/
+void *_malloc_alloc(void *ctx, size_t size)
+{
+  (void)ctx;
+  return malloc(size);
+}
+
+void *_malloc_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+  (void)ctx;
+  (void)old_size;
+  return realloc(ptr, new_size);
+}
+
+void _malloc_free(void *ctx, void *ptr, size_t size)
+{
+  (void)ctx;
+  (void)size;
+  free(ptr);
+}
+
+/*
+Internal functions for the arena allocator.
+Allocations larger than the block size get a block of their own, which
+is chained behind the current block so that it keeps being used.
+realloc grows the most recent allocation in place when there is room;
+otherwise it copies to a new allocation. free does nothing
+*/
+void *_arena_alloc(void *ctx, size_t size)
+{
+  arena_p arena = ctx;
+  size = _align_size(size);
+
+  if (size > arena->block_size)
+  {
+    if (arena->blocks == NULL)
+    {
+      arena->blocks = _block_create(NULL, size);
+      arena->blocks->used = size;
+      return arena->blocks->data;
+    }
+    _block_p block = _block_create(arena->blocks->next, size);
+    arena->blocks->next = block;
+    block->used = size;
+    return block->data;
+  }
+
+  if (arena->blocks == NULL || arena->blocks->used + size > arena->blocks->size)
+  {
+    arena->blocks = _block_create(arena->blocks, arena->block_size);
+  }
+
+  void *ptr = arena->blocks->data + arena->blocks->used;
+  arena->blocks->used += size;
+  return ptr;
+}
+
+void *_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+  arena_p arena = ctx;
+  if (ptr == NULL)
+    return _arena_alloc(ctx, new_size);
+
+  _block_p block = arena->blocks;
+  size_t old_aligned = _align_size(old_size);
+  size_t new_aligned = _align_size(new_size);
+
+  // Is ptr the most recent allocation in the current block?
+  if ((char *)ptr + old_aligned == block->data + block->used &&
+      block->used - old_aligned + new_aligned <= block->size)
+  {
+    block->used = block->used - old_aligned + new_aligned;
+    return ptr;
+  }
+
+  void *new_ptr = _arena_alloc(ctx, new_size);
+  memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+  return new_ptr;
+}
+
+void _arena_free(void *ctx, void *ptr, size_t size)
+{
+  (void)ctx;
+  (void)ptr;
+  (void)size;
+}
+
+/*
+Internal functions for the pool allocator.
+Objects come from the free list first, then from the current slab.
+Requests larger than the pool's object size (e.g. for the queue
+structure itself, rather than its elements) are passed to malloc.
+As the size is passed back to free and realloc, these can be told apart
+*/
+void *_pool_alloc(void *ctx, size_t size)
+{
+  pool_p pool = ctx;
+  if (size > pool->requested_size)
+    return malloc(size);
+
+  if (pool->free_list)
+  {
+    void *ptr = pool->free_list;
+    pool->free_list = *(void **)ptr;
+    return ptr;
+  }
+
+  if (pool->slabs == NULL || pool->slabs->used + pool->object_size > pool->slabs->size)
+  {
+    pool->slabs = _block_create(pool->slabs, pool->object_size * pool->objects_per_slab);
+  }
+
+  void *ptr = pool->slabs->data + pool->slabs->used;
+  pool->slabs->used += pool->object_size;
+  return ptr;
+}
+
+void *_pool_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+  pool_p pool = ctx;
+  if (ptr == NULL)
+    return _pool_alloc(ctx, new_size);
+
+  bool old_in_pool = old_size <= pool->requested_size;
+  bool new_in_pool = new_size <= pool->requested_size;
+  if (old_in_pool && new_in_pool)
+    return ptr;
+  if (!old_in_pool && !new_in_pool)
+    return realloc(ptr, new_size);
+
+  void *new_ptr = _pool_alloc(ctx, new_size);
+  if (new_ptr)
+  {
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    _pool_free(ctx, ptr, old_size);
+  }
+  return new_ptr;
+}
+
+void _pool_free(void *ctx, void *ptr, size_t size)
+{
+  pool_p pool = ctx;
+  if (ptr == NULL)
+    return;
+
+  if (size > pool->requested_size)
+  {
+    free(ptr);
+    return;
+  }
+
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file allocator.h
+ * @brief Public function prototypes for the allocator module
+ *
+ * An allocator is a table of alloc/realloc/free functions and a context
+ * pointer, which can be passed to list_create_ex and queue_create_ex so
+ * that all of a structure's memory comes from somewhere other than the
+ * system heap. Four allocators are provided:
+ * - the default allocator (malloc/realloc/free)
+ * - a bump arena, whose memory is all released at once by arena_reset/arena_delete
+ * - a slab pool of fixed size objects, which reuses freed objects via a free list
+ * - a page allocator, which maps large blocks directly (optionally with huge
+ *   pages and a NUMA placement policy) for big list data arrays
+ *
+ * Structures created with an allocator must still be deleted (list_delete,
+ * queue_delete) unless the allocator releases everything itself (arena).
+ *
+ * Example usage to build short-lived structures in an arena:
+ * arena_p arena = arena_create(0);
+ * allocator alloc = arena_allocator(arena);
+ * list_p my_list = list_create_ex(sizeof(int), &alloc);
+ * queue_p my_queue = queue_create_ex(sizeof(int), &alloc);
+ * ...
+ * arena_delete(arena); // frees my_list and my_queue in one shot
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+
+#ifndef ALLOCATOR
+#define ALLOCATOR
+
+/**
+ * @brief An allocator (function table plus context)
+ *
+ * The size of each block is passed back to realloc and free, so an
+ * allocator does not need to record it.
+ */
+typedef struct allocator
+{
+  void *(*alloc)(void *ctx, size_t size);
+  void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+  void (*free)(void *ctx, void *ptr, size_t size);
+  void *ctx;
+} allocator;
+
+/**
+ * @brief Data type representing a bump arena
+ */
+typedef struct arena *arena_p;
+
+/**
+ * @brief Data type representing a slab pool of fixed size objects
+ */
+typedef struct pool *pool_p;
+
+/**
+ * @brief Data type representing a page allocator
+ */
+typedef struct pages *pages_p;
+
+/**
+ * @brief Options for a page allocator (combine with |)
+ */
+typedef enum pages_flags
+{
+  PAGES_DEFAULT = 0,
+  PAGES_THP = 1,             // ask for transparent huge pages (madvise)
+  PAGES_HUGETLB = 2,         // use explicit huge pages (MAP_HUGETLB), falling back to PAGES_THP
+  PAGES_NUMA_BIND = 4,       // place pages only on the nodes in the node mask
+  PAGES_NUMA_INTERLEAVE = 8  // spread pages round-robin over the nodes in the node mask
+} pages_flags;
+
+/**
+ * @brief get the default allocator (malloc, realloc and free)
+ *
+ * @return The default allocator
+ */
+allocator allocator_default(void);
+
+/**
+ * @brief create a new bump arena
+ *
+ * Memory is handed out from blocks of block_size bytes by bumping a pointer.
+ * Freeing a single allocation does nothing; all memory is released by
+ * arena_reset or arena_delete.
+ *
+ * @param[in] block_size The size of each block (0 for a default of 64KB).
+ *                       Larger allocations get a block of their own.
+ * @return An arena_p (i.e. pointer to the arena) to the created arena
+ */
+arena_p arena_create(size_t block_size);
+
+/**
+ * @brief get an allocator which allocates from the arena
+ *
+ * @param[in] arena A pointer to an instance of the arena_p data type
+ * @return The allocator
+ */
+allocator arena_allocator(arena_p arena);
+
+/**
+ * @brief release all memory allocated from the arena, keeping the arena for reuse
+ *
+ * Any structure created with the arena's allocator must not be used afterwards.
+ *
+ * @param[in] arena A pointer to an instance of the arena_p data type
+ * @return nothing
+ */
+void arena_reset(arena_p arena);
+
+/**
+ * @brief delete the arena and release all memory allocated from it
+ *
+ * @param[in] arena A pointer to an instance of the arena_p data type
+ * @return nothing
+ */
+void arena_delete(arena_p arena);
+
+/**
+ * @brief create a new slab pool
+ *
+ * Objects are carved from slabs of objects_per_slab objects. Freed objects
+ * go on a free list and are handed out again before the slab is used.
+ * Allocations larger than object_size are passed to malloc/realloc/free,
+ * so e.g. a queue created with a pool allocator takes its elements from
+ * the pool and the (larger) queue structure from the heap.
+ * Use queue_node_size to size a pool for queue elements.
+ *
+ * @param[in] object_size The size of each object
+ * @param[in] objects_per_slab The number of objects in each slab
+ * @return A pool_p (i.e. pointer to the pool) to the created pool
+ */
+pool_p pool_create(size_t object_size, int objects_per_slab);
+
+/**
+ * @brief get an allocator which allocates objects from the pool
+ *
+ * @param[in] pool A pointer to an instance of the pool_p data type
+ * @return The allocator
+ */
+allocator pool_allocator(pool_p pool);
+
+/**
+ * @brief delete the pool and release all of its slabs
+ *
+ * @param[in] pool A pointer to an instance of the pool_p data type
+ * @return nothing
+ */
+void pool_delete(pool_p pool);
+
+/**
+ * @brief create a new page allocator
+ *
+ * Each allocation of at least 64KB is its own anonymous
+ * mapping, which is grown or shrunk by mremap (so a list's data array is
+ * not copied when it grows). Smaller allocations (e.g. the list structure)
+ * are passed to malloc/realloc/free.
+ *
+ * With PAGES_THP or PAGES_HUGETLB, mappings are rounded up to and aligned
+ * on huge pages (2MB), which cuts TLB misses for random access to large
+ * arrays. PAGES_HUGETLB needs huge pages reserved by the system
+ * (vm.nr_hugepages); when none are free it falls back to PAGES_THP.
+ *
+ * PAGES_NUMA_BIND and PAGES_NUMA_INTERLEAVE set the memory policy of each
+ * mapping (mbind) to the nodes in nodemask (bit n for node n), rather than
+ * the node of the thread which first touches each page. The policy is a
+ * hint: it is ignored where mbind is not supported (e.g. single-node
+ * machines without NUMA support in the kernel).
+ *
+ * Example usage for a large list interleaved over two nodes:
+ * pages_p pages = pages_create(PAGES_THP | PAGES_NUMA_INTERLEAVE, 0x3);
+ * allocator alloc = pages_allocator(pages);
+ * list_p my_list = list_create_ex(sizeof(double), &alloc);
+ * ...
+ * list_delete(my_list);
+ * pages_delete(pages);
+ *
+ * @param[in] flags The options (pages_flags, combined with |)
+ * @param[in] nodemask The NUMA nodes for PAGES_NUMA_BIND / PAGES_NUMA_INTERLEAVE
+ * @return A pages_p (i.e. pointer to the page allocator) to the created allocator
+ */
+pages_p pages_create(int flags, unsigned long nodemask);
+
+/**
+ * @brief get an allocator which maps pages with the options of the page allocator
+ *
+ * @param[in] pages A pointer to an instance of the pages_p data type
+ * @return The allocator
+ */
+allocator pages_allocator(pages_p pages);
+
+/**
+ * @brief delete the page allocator
+ *
+ * Memory allocated from it must be freed first (e.g. by list_delete).
+ *
+ * @param[in] pages A pointer to an instance of the pages_p data type
+ * @return nothing
+ */
+void pages_delete(pages_p pages);
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * allocator_p.h
+ *
+ * Private header file for allocator module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdlib.h>
+#include "allocator.h"
+
+#ifndef ALLOCATOR_P
+#define ALLOCATOR_P
+
+/**
+ * @brief Data type representing a block of an arena or a slab of a pool
+ */
+typedef struct _block *_block_p;
+
+size_t _align_size(size_t size);
+_block_p _block_create(_block_p next, size_t size);
+
+void *_malloc_alloc(void *ctx, size_t size);
+void *_malloc_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+void _malloc_free(void *ctx, void *ptr, size_t size);
+
+void *_arena_alloc(void *ctx, size_t size);
+void *_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+void _arena_free(void *ctx, void *ptr, size_t size);
+
+void *_pool_alloc(void *ctx, size_t size);
+void *_pool_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+void _pool_free(void *ctx, void *ptr, size_t size);
+
+// Page allocator (allocator_pages.c)
+#define PAGES_MIN_SIZE (64 * 1024)
+
+size_t _pages_round(pages_p pages, size_t size);
+void _pages_apply(pages_p pages, char *ptr, size_t length);
+void *_pages_map(pages_p pages, size_t length);
+
+void *_pages_alloc(void *ctx, size_t size);
+void *_pages_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+void _pages_free(void *ctx, void *ptr, size_t size);
+
+#endif
@@ -0,0 +1,259 @@
+/**
+ * allocator_pages.c
+ *
+ * Implementation of the page allocator for the allocator module
+ *
+ * Large allocations are anonymous mappings. Their lengths are rounded up
+ * to whole pages (whole huge pages when huge pages are requested), and as
+ * the size of each block is passed back to realloc and free, the length
+ * of its mapping can always be worked out again without being recorded.
+ *
+ * The NUMA policy is set with the mbind system call directly, so that
+ * libnuma is not needed (its constants are defined here for the same reason).
+ *
+ * @author ruairin
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "allocator_p.h"
+
+// The size of a huge page (x86-64 and the usual arm64 configuration)
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Memory policies for mbind (from linux/mempolicy.h)
+#define MPOL_BIND 2
+#define MPOL_INTERLEAVE 3
+
+/*
+The page allocator data type for the allocator module
+*/
+typedef struct pages
+{
+  int flags;
+  unsigned long nodemask;
+  size_t page_size; // the unit that mapping lengths are rounded to
+} *pages_p;
+
+/*
+Creates a new page allocator
+
+Inputs:
+  flags - the options (pages_flags, combined with |)
+  nodemask - the NUMA nodes for PAGES_NUMA_BIND / PAGES_NUMA_INTERLEAVE
+
+Returns:
+  A pages_p (pointer to the newly created page allocator)
+
+Throws:
+  aborts if the memory allocation fails
+
+*/
+pages_p pages_create(int flags, unsigned long nodemask)
+{
+  pages_p pages;
+  pages = (pages_p)malloc(sizeof(struct pages));
+  assert(pages != NULL && "Error in memory allocation");
+
+  pages->flags = flags;
+  pages->nodemask = nodemask;
+  if (flags & (PAGES_THP | PAGES_HUGETLB))
+    pages->page_size = HUGE_PAGE_SIZE;
+  else
+    pages->page_size = (size_t)sysconf(_SC_PAGESIZE);
+  return pages;
+}
+
+/*
+Gets an allocator which maps pages with the options of the page allocator
+
+Inputs:
+  pages - pointer to an instance of the page allocator type
+
+Returns:
+  The allocator
+
+*/
+allocator pages_allocator(pages_p pages)
+{
+  allocator alloc = {_pages_alloc, _pages_realloc, _pages_free, pages};
+  return alloc;
+}
+
+/*
+Frees the page allocator (but not the memory allocated from it)
+
+Inputs:
+  pages - pointer to an instance of the page allocator type
+
+Returns:
+  Nothing
+
+*/
+void pages_delete(pages_p pages)
+{
+  free(pages);
+}
+
+/*
+Internal function to round a size up to the length of its mapping
+
+Inputs:
+  pages - pointer to an instance of the page allocator type
+  size - the size in bytes
+
+Returns:
+  The length of the mapping
+
+*/
+size_t _pages_round(pages_p pages, size_t size)
+{
+  return (size + pages->page_size - 1) / pages->page_size * pages->page_size;
+}
+
+/*
+Internal function to apply the huge page and NUMA options to a mapping.
+Errors are ignored, as the options only affect performance
+
+Inputs:
+  pages - pointer to an instance of the page allocator type
+  ptr - the start of the mapping
+  length - the length of the mapping
+
+Returns:
+  Nothing
+
+*/
+void _pages_apply(pages_p pages, char *ptr, size_t length)
+{
+  if (pages->flags & (PAGES_THP | PAGES_HUGETLB))
+    madvise(ptr, length, MADV_HUGEPAGE);
+
+  if (pages->flags & (PAGES_NUMA_BIND | PAGES_NUMA_INTERLEAVE))
+  {
+    int mode = (pages->flags & PAGES_NUMA_INTERLEAVE) ? MPOL_INTERLEAVE : MPOL_BIND;
+    unsigned long maxnode = sizeof(pages->nodemask) * 8 + 1;
+    syscall(SYS_mbind, ptr, length, mode, &pages->nodemask, maxnode, 0);
+  }
+}
+
+/*
+Internal function to create a mapping with the options of the page allocator.
+Explicit huge pages are tried first (if requested). Otherwise the
+mapping is aligned on a huge page (if requested) by over-allocating and
+trimming the ends, so that transparent huge pages can back all of it
+
+Inputs:
+  pages - pointer to an instance of the page allocator type
+  length - the length of the mapping (from _pages_round)
+
+Returns:
+  The start of the mapping, or NULL if it cannot be mapped
+
+*/
+void *_pages_map(pages_p pages, size_t length)
+{
+  char *ptr;
+  if (pages->flags & PAGES_HUGETLB)
+  {
+    ptr = mmap(NULL, length, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+    {
+      _pages_apply(pages, ptr, length);
+      return ptr;
+    }
+  }
+
+  size_t extra = (pages->page_size > (size_t)sysconf(_SC_PAGESIZE)) ? pages->page_size : 0;
+  ptr = mmap(NULL, length + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED)
+    return NULL;
+
+  if (extra)
+  {
+    char *aligned = (char *)(((uintptr_t)ptr + extra - 1) / extra * extra);
+    if (aligned > ptr)
+      munmap(ptr, aligned - ptr);
+    if (aligned + length < ptr + length + extra)
+      munmap(aligned + length, ptr + extra - aligned);
+    ptr = aligned;
+  }
+  _pages_apply(pages, ptr, length);
+  return ptr;
+}
+
+/*
+Internal functions for the page allocator.
+Allocations smaller than PAGES_MIN_SIZE are passed to malloc; as for the
+pool, the size passed back to realloc and free tells the two apart.
+realloc moves a mapping with mremap, which remaps the pages rather than
+copying them. Explicit huge page mappings which cannot be resized in
+place are copied to a new mapping instead
+*/
+void *_pages_alloc(void *ctx, size_t size)
+{
+  pages_p pages = ctx;
+  if (size < PAGES_MIN_SIZE)
+    return malloc(size);
+
+  return _pages_map(pages, _pages_round(pages, size));
+}
+
+void *_pages_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+  pages_p pages = ctx;
+  if (ptr == NULL)
+    return _pages_alloc(ctx, new_size);
+
+  bool old_mapped = old_size >= PAGES_MIN_SIZE;
+  bool new_mapped = new_size >= PAGES_MIN_SIZE;
+  if (!old_mapped && !new_mapped)
+    return realloc(ptr, new_size);
+
+  if (old_mapped && new_mapped)
+  {
+    size_t old_length = _pages_round(pages, old_size);
+    size_t new_length = _pages_round(pages, new_size);
+    if (old_length == new_length)
+      return ptr;
+
+    char *new_ptr = mremap(ptr, old_length, new_length, MREMAP_MAYMOVE);
+    if (new_ptr != MAP_FAILED)
+    {
+      // The grown part of the mapping needs the options too
+      _pages_apply(pages, new_ptr, new_length);
+      return new_ptr;
+    }
+  }
+
+  void *new_ptr = _pages_alloc(ctx, new_size);
+  if (new_ptr)
+  {
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    _pages_free(ctx, ptr, old_size);
+  }
+  return new_ptr;
+}
+
+void _pages_free(void *ctx, void *ptr, size_t size)
+{
+  pages_p pages = ctx;
+  if (ptr == NULL)
+    return;
+
+  if (size < PAGES_MIN_SIZE)
+  {
+    free(ptr);
+    return;
+  }
+
+  munmap(ptr, _pages_round(pages, size));
+}
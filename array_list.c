@@ -11,35 +11,69 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <string.h>
+#include <limits.h>
 #include "array_list_p.h"
+#include "perf_counters_p.h"
 
 // The initial capacity of the data array
 #define INITIAL_CAPACITY 16
 
-// The factor by which the array grows when
+// The default factor by which the array grows when
 // its capacity is exceeded
 #define CAPACITY_GROW_FACTOR 2
+// The default factor by which the array shrinks when
+// the size falls to CAPACITY_SHRINK_THRESHOLD of the capacity
 #define CAPACITY_SHRINK_FACTOR 0.5
+#define CAPACITY_SHRINK_THRESHOLD 0.25
 
-#define DEBUG 0
+/*
+Creates and initialises a new list using the list_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the list
+
+Returns:
+  A list_p (pointer to the newly created list) is returned
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+list_p list_create(size_t element_size)
+{
+  // From the user's viewpoint, the intial size of the list is 0
+  // but internally the capacity is set via INITIAL_CAPACITY
+  return list_create_with_capacity(element_size, INITIAL_CAPACITY);
+}
 
 /*
-The list data type for the array_list module
-Data is a char because pointer arithmetic is used
+Creates and initialises a new list with room for capacity elements
+before the data array needs to grow
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the list
+  capacity - the initial capacity of the data array (at least 1)
+
+Returns:
+  A list_p (pointer to the newly created list) is returned
+
+Throws:
+  aborts if the capacity is not positive or if the memory allocations fail
+
 */
-typedef struct list
+list_p list_create_with_capacity(size_t element_size, int capacity)
 {
-  char *data;
-  int size;
-  int capacity;
-  size_t element_size;
-} *list_p;
+  allocator alloc = allocator_default();
+  return _list_create(element_size, capacity, &alloc);
+}
 
 /*
-Creates and initialises a new list using the list_p type
+Creates and initialises a new list whose memory (the list itself and
+its data array) comes from the given allocator
 
 Inputs:
   element_size - the size of the primitive data type to be stored in the list
+  alloc - the allocator (copied into the list)
 
 Returns:
   A list_p (pointer to the newly created list) is returned
@@ -48,18 +82,70 @@ Throws:
   aborts if the memory allocations fail
 
 */
-list_p list_create(size_t element_size)
+list_p list_create_ex(size_t element_size, const allocator *alloc)
+{
+  return _list_create(element_size, INITIAL_CAPACITY, alloc);
+}
+
+/*
+Creates and initialises a new unordered list, for which list_remove
+moves the last item into the removed item's place (see list_swap_remove)
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the list
+
+Returns:
+  A list_p (pointer to the newly created list) is returned
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+list_p list_create_unordered(size_t element_size)
+{
+  list_p list = list_create(element_size);
+  list->unordered = true;
+  return list;
+}
+
+/*
+Internal function to create and initialise a new list
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the list
+  capacity - the initial capacity of the data array (at least 1)
+  alloc - the allocator for the list and its data array
+
+Returns:
+  A list_p (pointer to the newly created list) is returned
+
+Throws:
+  aborts if the capacity is not positive or if the memory allocations fail
+
+*/
+list_p _list_create(size_t element_size, int capacity, const allocator *alloc)
 {
+  assert(capacity > 0 && "Error: List capacity must be positive");
+
   list_p list;
-  list = (list_p)malloc(sizeof(struct list));
+  list = (list_p)alloc->alloc(alloc->ctx, sizeof(struct list));
   assert(list != NULL && "Error in memory allocation");
 
-  // From the user's viewpoint, the intial size of the list is 0
-  // but internally the capacity is set via INITIAL_CAPACITY
+  list->alloc = *alloc;
   list->size = 0;
-  list->capacity = INITIAL_CAPACITY;
+  list->capacity = capacity;
   list->element_size = element_size;
-  list->data = malloc(list->capacity * list->element_size);
+  list->grow_factor = CAPACITY_GROW_FACTOR;
+  list->grow_chunk = 0;
+  list->shrink_threshold = CAPACITY_SHRINK_THRESHOLD;
+  list->shrink_factor = CAPACITY_SHRINK_FACTOR;
+  list->mapping = NULL;
+  memset(&list->stats, 0, sizeof(list->stats));
+  list->stats.peak_capacity = capacity;
+  list->resize_trace = NULL;
+  list->resize_trace_ctx = NULL;
+  list->unordered = false;
+  list->data = list->alloc.alloc(list->alloc.ctx, list->capacity * list->element_size);
   assert(list->data != NULL && "Error in memory allocation");
 
   return list;
@@ -94,6 +180,52 @@ void list_get(list_p list, int index, void *out)
   memcpy(out, _data_ptr(list, index), list->element_size);
 }
 
+/*
+Gets a read-only pointer to the list item at the specified index,
+without copying it. The pointer is invalidated by anything that can
+move the data array (_resize) or shift elements (insert/remove)
+
+Inputs:
+  list - pointer to an instance of the list type
+  index - the array index
+
+Returns:
+  A pointer to the element at index in list->data
+
+Throws:
+  aborts if the specified index is outside the list bounds
+  based on the current list size (list->size variable)
+
+*/
+const void *list_at(list_p list, int index)
+{
+  assert(!(_is_index_outside_bounds(list->size, index)) && "Error: list index out of range");
+  return _data_ptr(list, index);
+}
+
+/*
+Gets the contiguous block of list items (list->data) and the number of
+items in it. The same invalidation rules as for list_at apply
+
+Inputs:
+  list - pointer to an instance of the list type
+  data - address of a pointer to store the start of the block
+  length - address of a variable to store the number of items
+
+Outputs:
+  data - pointer to the first element of list->data
+  length - the current size of the list
+
+Returns:
+  Nothing
+
+*/
+void list_data_span(list_p list, const void **data, int *length)
+{
+  *data = list->data;
+  *length = list->size;
+}
+
 /*
 Gets the list item at the specified index
 
@@ -141,6 +273,27 @@ void list_append(list_p list, void *value)
   list_insert(list, value, list->size);
 }
 
+/*
+Appends count values to the end of the list by calling
+list_insert_n with an index equal to the size of the list
+
+Inputs:
+  list - pointer to an instance of the list type
+  src - Pointer to the first of count consecutive values to be appended
+  count - the number of values to be appended
+
+Returns:
+  Nothing
+
+Throws:
+  list_insert_n aborts if there is insufficient capacity to append the items
+
+*/
+void list_append_n(list_p list, const void *src, size_t count)
+{
+  list_insert_n(list, src, count, list->size);
+}
+
 /*
 Inserts a new value at the specified index
 
@@ -162,11 +315,6 @@ Throws:
 */
 void list_insert(list_p list, void *value, int index)
 {
-  // Check that there's capacity to insert another item
-  if (_is_list_full(list))
-  {
-    _grow_array(list);
-  }
   // Check that the specified index is not outside the bounds
   // of the list **following the update**. This allows items to appended
   // using e.g.
@@ -174,26 +322,77 @@ void list_insert(list_p list, void *value, int index)
   // but doesnt allow inserting at an index that's not adjacent to the
   // current upper bound e.g.
   // list_insert(my_list, my_value, list_size(my_list) + 1)
-  char error[64] = "";
-  sprintf(error, "Error: Cannot add element at index %d.\n", index);
-  assert(!(_is_index_outside_bounds(list->size + 1, index)) && error);
+  // The message is a constant so that no formatting is done on the success path
+  assert(!(_is_index_outside_bounds(list->size + 1, index)) && "Error: Cannot add element at index");
+  PERF_BEGIN();
 
-  // shift elements to the right
-  // by looping backwards from the end
-  for (int i = list->size; i > index; i--)
+  // Check that there's capacity to insert another item
+  if (_is_list_full(list))
   {
-    // list->data[i] = list->data[i - 1];
-    memcpy(_data_ptr(list, i),
-           _data_ptr(list, i - 1),
-           list->element_size);
+    _grow_array(list);
   }
+
+  // shift elements from index onwards one place to the right
+  // in a single block move (the regions overlap)
+  memmove(_data_ptr(list, index + 1),
+          _data_ptr(list, index),
+          (size_t)(list->size - index) * list->element_size);
   // list->data[index] = value;
   memcpy(_data_ptr(list, index), value, list->element_size);
   list->size++;
+  LIST_STAT(list->stats.inserts++);
+  LIST_STAT(list->stats.shift_bytes += (long long)(list->size - 1 - index) * list->element_size);
+  PERF_END(PERF_LIST_INSERT);
 }
 
 /*
-Removed the item at the specified index
+Inserts count new values starting at the specified index
+
+Unlike calling list_insert count times, the capacity is checked (and grown)
+once, the existing elements from index onwards are moved right in a single
+memmove and the new values are copied in a single memcpy.
+
+Inputs:
+  list - pointer to an instance of the list type
+  src - Pointer to the first of count consecutive values to be inserted
+  count - the number of values to be inserted
+  index - the list index to insert the first value
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if there is insufficient capacity to insert the items or if the specified
+  index is out of the bounds of the expanded list
+
+*/
+void list_insert_n(list_p list, const void *src, size_t count, int index)
+{
+  // As for list_insert, index may be equal to the current size (append)
+  assert(!(_is_index_outside_bounds(list->size + 1, index)) && "Error: Cannot add elements at index");
+  assert(count <= (size_t)(INT_MAX - list->size) && "Error: Too many elements for list");
+
+  if (count == 0)
+    return;
+
+  _ensure_capacity(list, list->size + (int)count);
+
+  // shift the tail right to make a gap of count elements
+  memmove(_data_ptr(list, index + (int)count),
+          _data_ptr(list, index),
+          (size_t)(list->size - index) * list->element_size);
+  memcpy(_data_ptr(list, index), src, count * list->element_size);
+  LIST_STAT(list->stats.inserts += count);
+  LIST_STAT(list->stats.shift_bytes += (long long)(list->size - index) * list->element_size);
+  list->size += (int)count;
+}
+
+/*
+Removed the item at the specified index.
+For an unordered list this is list_swap_remove
 
 Inputs:
   list - pointer to an instance of the list type
@@ -211,28 +410,155 @@ Throws:
 */
 void list_remove(list_p list, int index)
 {
-  if (_is_list_too_empty(list))
+  assert(!(_is_index_outside_bounds(list->size, index)) && "Error: Cannot remove element at index");
+  if (list->unordered)
   {
-    _shrink_array(list);
+    list_swap_remove(list, index);
+    return;
   }
+  PERF_BEGIN();
 
-  char error[64] = "";
-  sprintf(error, "Error: Cannot remove element at index %d.\n", index);
-  assert(!(_is_index_outside_bounds(list->size, index)) && error);
-
-  // Shift elements to the left
-  for (int i = index; i < list->size - 1; i++)
+  if (_is_list_too_empty(list))
   {
-    // list->data[i] = list->data[i + 1];
-    memcpy(_data_ptr(list, i), _data_ptr(list, i + 1), list->element_size);
+    _shrink_array(list);
   }
 
-  // Set the last item to zero
+  // Shift elements after index one place to the left
+  // in a single block move (the regions overlap)
+  memmove(_data_ptr(list, index),
+          _data_ptr(list, index + 1),
+          (size_t)(list->size - index - 1) * list->element_size);
+  list->size--;
+  LIST_STAT(list->stats.removes++);
+  LIST_STAT(list->stats.shift_bytes += (long long)(list->size - index) * list->element_size);
+
+  // Set the vacated last item to zero
   // This is now outside the list bounds
   // following the removal
-  // list->data[list->size] = 0;
   memset(_data_ptr(list, list->size), 0, list->element_size);
+  PERF_END(PERF_LIST_REMOVE);
+}
+
+/*
+Removes the item at the specified index by moving the last item
+into its place, so that nothing is shifted (the order of the items
+is not kept)
+
+Inputs:
+  list - pointer to an instance of the list type
+  index - the list index of the item to remove
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the specified index is out of the current bounds of the list
+
+*/
+void list_swap_remove(list_p list, int index)
+{
+  assert(!(_is_index_outside_bounds(list->size, index)) && "Error: Cannot remove element at index");
+  PERF_BEGIN();
+
+  if (_is_list_too_empty(list))
+  {
+    _shrink_array(list);
+  }
+
   list->size--;
+  if (index != list->size)
+  {
+    memcpy(_data_ptr(list, index), _data_ptr(list, list->size), list->element_size);
+    LIST_STAT(list->stats.shift_bytes += list->element_size);
+  }
+  LIST_STAT(list->stats.removes++);
+
+  // Set the vacated last item to zero, as for list_remove
+  memset(_data_ptr(list, list->size), 0, list->element_size);
+  PERF_END(PERF_LIST_REMOVE);
+}
+
+/*
+Removes every item for which predicate returns true, in a single
+compaction pass (see _compact)
+
+Inputs:
+  list - pointer to an instance of the list type
+  predicate - function called with each item and ctx
+  ctx - pointer passed through to predicate
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  The number of items removed
+
+*/
+int list_remove_if(list_p list, list_predicate_fn predicate, void *ctx)
+{
+  return _compact(list, predicate, ctx, true);
+}
+
+/*
+Keeps only the items for which predicate returns true, in a single
+compaction pass (see _compact)
+
+Inputs:
+  list - pointer to an instance of the list type
+  predicate - function called with each item and ctx
+  ctx - pointer passed through to predicate
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  The number of items removed
+
+*/
+int list_retain(list_p list, list_predicate_fn predicate, void *ctx)
+{
+  return _compact(list, predicate, ctx, false);
+}
+
+/*
+Removes the items in the index range [from, to)
+
+Inputs:
+  list - pointer to an instance of the list type
+  from - the list index of the first item to remove
+  to - the list index after the last item to remove
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the range is not within the bounds of the list
+
+*/
+void list_remove_range(list_p list, int from, int to)
+{
+  assert(from >= 0 && from <= to && to <= list->size && "Error: Cannot remove elements in range");
+  if (from == to)
+    return;
+
+  // Shift the items after the range left in a single block move
+  int count = to - from;
+  memmove(_data_ptr(list, from),
+          _data_ptr(list, to),
+          (size_t)(list->size - to) * list->element_size);
+  LIST_STAT(list->stats.removes += count);
+  LIST_STAT(list->stats.shift_bytes += (long long)(list->size - to) * list->element_size);
+  list->size -= count;
+
+  // As for list_remove, the vacated items are set to zero
+  memset(_data_ptr(list, list->size), 0, (size_t)count * list->element_size);
+  _shrink_after_removal(list);
 }
 
 /*
@@ -250,6 +576,173 @@ int list_size(list_p list)
   return list->size;
 }
 
+/*
+Get the current capacity (i.e. the number of elements that fit in the
+data array before it has to grow) of the list
+
+Inputs:
+  list - pointer to an instance of the list type
+
+Returns:
+  The current capacity of the list
+
+*/
+int list_capacity(list_p list)
+{
+  return list->capacity;
+}
+
+/*
+Grows the data array so that it can hold at least capacity elements.
+The capacity is never reduced (see list_shrink_to_fit)
+
+Inputs:
+  list - pointer to an instance of the list type
+  capacity - the number of elements the list must be able to hold
+
+Outputs:
+  list - resized list->data array, updated list->capacity
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if memory allocation fails
+
+*/
+void list_reserve(list_p list, int capacity)
+{
+  if (capacity > list->capacity)
+  {
+    _resize(list, capacity);
+  }
+}
+
+/*
+Shrinks the data array to the current size of the list
+(or to one element if the list is empty)
+
+Inputs:
+  list - pointer to an instance of the list type
+
+Outputs:
+  list - resized list->data array, updated list->capacity
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if memory allocation fails
+
+*/
+void list_shrink_to_fit(list_p list)
+{
+  int capacity = list->size > 0 ? list->size : 1;
+  if (capacity != list->capacity)
+  {
+    _resize(list, capacity);
+  }
+}
+
+/*
+Sets how the data array grows when it is full
+
+Inputs:
+  list - pointer to an instance of the list type
+  factor - the factor by which the capacity is multiplied (> 1), used if chunk is 0
+  chunk - if > 0, the number of elements by which the capacity is increased
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if neither the factor nor the chunk would grow the array
+
+*/
+void list_set_growth_policy(list_p list, double factor, int chunk)
+{
+  assert(chunk >= 0 && "Error: Growth chunk cannot be negative");
+  assert((chunk > 0 || factor > 1) && "Error: Growth factor must be greater than 1");
+
+  list->grow_factor = factor;
+  list->grow_chunk = chunk;
+}
+
+/*
+Sets how the data array shrinks as items are removed.
+
+The array shrinks to capacity * factor once the size falls to
+capacity * threshold. Keeping threshold well below factor leaves
+headroom after each shrink (hysteresis), so a list whose size
+oscillates does not repeatedly shrink and grow.
+
+Inputs:
+  list - pointer to an instance of the list type
+  threshold - the fraction of the capacity at or below which the array shrinks
+              (0 disables shrinking)
+  factor - the factor by which the capacity is multiplied when shrinking
+
+Returns:
+  Nothing
+
+Throws:
+  aborts unless 0 <= threshold < factor < 1
+
+*/
+void list_set_shrink_policy(list_p list, double threshold, double factor)
+{
+  assert(threshold >= 0 && threshold < factor && factor < 1 &&
+         "Error: Shrink policy must satisfy 0 <= threshold < factor < 1");
+
+  list->shrink_threshold = threshold;
+  list->shrink_factor = factor;
+}
+
+/*
+Gets the operation statistics of the list
+(which are only kept when built with DS_STATS)
+
+Inputs:
+  list - pointer to an instance of the list type
+  stats - pointer to the statistics to fill in
+
+Outputs:
+  stats - the statistics (all zero unless built with DS_STATS)
+
+Returns:
+  true if statistics are kept
+
+*/
+bool list_stats(list_p list, list_statistics *stats)
+{
+#ifdef DS_STATS
+  *stats = list->stats;
+  return true;
+#else
+  (void)list;
+  memset(stats, 0, sizeof(*stats));
+  return false;
+#endif
+}
+
+/*
+Sets a function to be called after each resize of the list
+
+Inputs:
+  list - pointer to an instance of the list type
+  trace - the function (NULL to stop tracing)
+  ctx - pointer passed through to the function
+
+Returns:
+  Nothing
+
+*/
+void list_set_resize_trace(list_p list, list_resize_trace_fn trace, void *ctx)
+{
+  list->resize_trace = trace;
+  list->resize_trace_ctx = ctx;
+}
+
 /*
 Frees the memory allocated to list
 
@@ -264,9 +757,13 @@ void list_delete(list_p list)
 {
   if (list)
   {
-    if (list->data)
-      free(list->data);
-    free(list);
+    // Copy the allocator, as it is stored in the list being freed
+    allocator alloc = list->alloc;
+    if (list->mapping)
+      _unmap_list(list);
+    else if (list->data)
+      alloc.free(alloc.ctx, list->data, list->capacity * list->element_size);
+    alloc.free(alloc.ctx, list, sizeof(struct list));
   }
 }
 
@@ -312,9 +809,9 @@ bool _is_list_full(list_p list)
 /*
 Internal function to check if the list is too empty
 In this implementaion the list is too empty if the
-actual number of elements is less than a quarter of the capacity
-This is based on examples in data structures & algorithms
-(goodrich)
+actual number of elements is less than list->shrink_threshold of the capacity
+(a quarter by default, based on examples in data structures & algorithms
+(goodrich)). Lists of up to INITIAL_CAPACITY elements are never too empty
 
 Inputs:
   list - pointer to an instance of the list type
@@ -326,15 +823,14 @@ Returns:
 */
 bool _is_list_too_empty(list_p list)
 {
-  int quarter_capacity = list->capacity >> 2;
-  if (list->size <= quarter_capacity && list->size > INITIAL_CAPACITY)
+  if (list->size <= list->capacity * list->shrink_threshold && list->size > INITIAL_CAPACITY)
     return true;
   return false;
 }
 
 /*
 Internal wrapper to grow array size.
-The CAPACITY_GROW_FACTOR of 2 is based on
+The default CAPACITY_GROW_FACTOR of 2 is based on
 data structures & algorithms (goodrich)
 
 Inputs:
@@ -345,13 +841,63 @@ Returns:
 */
 void _grow_array(list_p list)
 {
-  int new_capacity = list->capacity * CAPACITY_GROW_FACTOR;
+  int new_capacity = _grown_capacity(list, list->capacity);
+  _resize(list, new_capacity);
+}
+
+/*
+Internal function to apply the growth policy of the list to a capacity
+
+Inputs:
+  list - pointer to an instance of the list type
+  capacity - the capacity before growing
+
+Returns:
+  The capacity after growing once (at least capacity + 1, at most INT_MAX)
+*/
+int _grown_capacity(list_p list, int capacity)
+{
+  double new_capacity;
+  if (list->grow_chunk > 0)
+    new_capacity = (double)capacity + list->grow_chunk;
+  else
+    new_capacity = capacity * list->grow_factor;
+
+  if (new_capacity < (double)capacity + 1)
+    new_capacity = (double)capacity + 1;
+  if (new_capacity > INT_MAX)
+    new_capacity = INT_MAX;
+  return (int)new_capacity;
+}
+
+/*
+Internal function to make sure there is capacity for at least
+required elements. The capacity grows by the growth policy
+(as for _grow_array) until it is large enough, but the array is
+only resized once.
+
+Inputs:
+  list - pointer to an instance of the list type
+  required - the number of elements which must fit in the array
+
+Returns:
+  Nothing
+*/
+void _ensure_capacity(list_p list, int required)
+{
+  if (required <= list->capacity)
+    return;
+
+  int new_capacity = list->capacity;
+  while (new_capacity < required)
+    new_capacity = _grown_capacity(list, new_capacity);
+
   _resize(list, new_capacity);
 }
 
 /*
 Internal wrapper to shrink array size.
-The CAPACITY_SHRINK_FACTOR of 0.25 is based on
+The default CAPACITY_SHRINK_FACTOR of 0.5 is based on
 data structures & algorithms (goodrich)
 
 Inputs:
@@ -362,14 +908,103 @@ Returns:
 */
 void _shrink_array(list_p list)
 {
-  int new_capacity = list->capacity * CAPACITY_SHRINK_FACTOR;
+  int new_capacity = list->capacity * list->shrink_factor;
+  // Never shrink below the number of elements in use
+  if (new_capacity < list->size)
+    new_capacity = list->size;
+  _resize(list, new_capacity);
+}
+
+/*
+Internal function to apply the shrink policy once after many items
+have been removed: the capacity is multiplied by the shrink factor as
+many times as list_remove would have shrunk it, but the array is
+only resized once. A shrink threshold of 0 disables shrinking, as for
+list_remove. Unlike _is_list_too_empty, the number of items left does
+not matter: a list which has been (nearly) cleared is shrunk down to
+INITIAL_CAPACITY, so that bulk removal from a large list frees its memory
+
+Inputs:
+  list - pointer to an instance of the list type
+
+Returns:
+  Nothing
+*/
+void _shrink_after_removal(list_p list)
+{
+  if (!(list->shrink_threshold > 0 && list->capacity > INITIAL_CAPACITY &&
+        list->size <= list->capacity * list->shrink_threshold))
+    return;
+
+  int new_capacity = list->capacity;
+  while (new_capacity > INITIAL_CAPACITY && list->size <= new_capacity * list->shrink_threshold)
+    new_capacity = new_capacity * list->shrink_factor;
+  if (new_capacity < INITIAL_CAPACITY)
+    new_capacity = INITIAL_CAPACITY;
+  // Never shrink below the number of elements in use
+  if (new_capacity < list->size)
+    new_capacity = list->size;
   _resize(list, new_capacity);
 }
 
+/*
+Internal function to remove the items which match (or, for retain,
+do not match) a predicate in a single pass. Each run of kept items
+is moved down to the end of the previous run with one memmove, so
+every item is moved at most once
+
+Inputs:
+  list - pointer to an instance of the list type
+  predicate - function called with each item and ctx
+  ctx - pointer passed through to predicate
+  remove_matching - true to remove the items for which predicate is true,
+                    false to keep them (and remove the rest)
+
+Outputs:
+  list - updated list->data array, updated list->size
+
+Returns:
+  The number of items removed
+*/
+int _compact(list_p list, list_predicate_fn predicate, void *ctx, bool remove_matching)
+{
+  int size = list->size;
+  int write = 0; // the end of the items kept so far
+  int start = 0; // the start of the current run of kept items
+  for (int read = 0; read <= size; read++)
+  {
+    // A run of kept items ends at a removed item (or the end of the list)
+    if (read == size || predicate(_data_ptr(list, read), ctx) == remove_matching)
+    {
+      int run = read - start;
+      if (run > 0 && start != write)
+      {
+        memmove(_data_ptr(list, write), _data_ptr(list, start), (size_t)run * list->element_size);
+        LIST_STAT(list->stats.shift_bytes += (long long)run * list->element_size);
+      }
+      write += run;
+      start = read + 1;
+    }
+  }
+
+  int removed = size - write;
+  if (removed == 0)
+    return 0;
+
+  list->size = write;
+  LIST_STAT(list->stats.removes += removed);
+  // As for list_remove, the vacated items are set to zero
+  memset(_data_ptr(list, write), 0, (size_t)removed * list->element_size);
+  _shrink_after_removal(list);
+  return removed;
+}
+
 /*
 Internal function to resize array.
-The CAPACITY_SHRINK_FACTOR of 0.25 is based on
-data structures & algorithms (goodrich)
+The new capacity is chosen by the caller from the list's own policy
+(list->grow_factor/grow_chunk, list->shrink_threshold/shrink_factor,
+see list_set_growth_policy and list_set_shrink_policy)
+The data array of a mapped list is resized with its file (_resize_mapped)
 
 Inputs:
   list - pointer to an instance of the list type
@@ -386,15 +1021,41 @@ Throws:
 */
 void _resize(list_p list, int capacity)
 {
+  PERF_BEGIN();
+  int old_capacity = list->capacity;
+  if (list->mapping)
+  {
+    _resize_mapped(list, capacity);
+  }
+  else
+  {
+    char *old_data = list->data;
+    list->data = list->alloc.realloc(list->alloc.ctx, list->data,
+                                     list->capacity * list->element_size,
+                                     capacity * list->element_size);
+    assert(list->data != NULL && "Error: Cannot resize list (Memory allocation failed).\n");
+    list->capacity = capacity;
+
+#ifdef DS_STATS
+    // realloc copies the array only if it moves it
+    if (list->data != old_data)
+      list->stats.bytes_copied += (long long)(old_capacity < capacity ? old_capacity : capacity) *
+                                  list->element_size;
+#endif
+    (void)old_data;
+  }
 
-  list->data = realloc(list->data, capacity * list->element_size);
-  assert(list->data != NULL && "Error: Cannot resize list (Memory allocation failed).\n");
-
-  list->capacity = capacity;
-
-#if DEBUG
-  printf("Resize: Current capacity %d\n", capacity);
+#ifdef DS_STATS
+  if (capacity > old_capacity)
+    list->stats.grows++;
+  else if (capacity < old_capacity)
+    list->stats.shrinks++;
+  if (capacity > list->stats.peak_capacity)
+    list->stats.peak_capacity = capacity;
 #endif
+  if (list->resize_trace)
+    list->resize_trace(list, old_capacity, capacity, list->resize_trace_ctx);
+  PERF_END(PERF_LIST_RESIZE);
 }
 
 /*
@@ -9,6 +9,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "allocator.h"
 
 #ifndef ARRAY_LIST
 #define ARRAY_LIST
@@ -18,6 +21,31 @@
  */
 typedef struct list *list_p;
 
+/**
+ * @brief Operation statistics for a list (see list_stats)
+ */
+typedef struct list_statistics
+{
+  long long grows;          // number of times the capacity increased
+  long long shrinks;        // number of times the capacity decreased
+  long long bytes_copied;   // bytes copied by realloc when the data array moved
+  int peak_capacity;        // largest capacity (items)
+  long long inserts;        // items inserted (or appended)
+  long long removes;        // items removed
+  long long shift_bytes;    // bytes moved to open or close gaps by insert/remove
+} list_statistics;
+
+/**
+ * @brief Function called each time the capacity of a list changes
+ *        (see list_set_resize_trace)
+ */
+typedef void (*list_resize_trace_fn)(list_p list, int old_capacity, int new_capacity, void *ctx);
+
+/**
+ * @brief Function which tests an item (see list_remove_if and list_retain)
+ */
+typedef bool (*list_predicate_fn)(const void *value, void *ctx);
+
 /**
  * @brief create and initialise a new list
  *
@@ -31,6 +59,109 @@ typedef struct list *list_p;
  */
 list_p list_create(size_t element_size);
 
+/**
+ * @brief create and initialise a new list with a given initial capacity
+ *
+ * The initial size of the list is zero, but capacity items can be added
+ * before the data array needs to grow. Use this when the final size of
+ * the list is known (or can be estimated) up front.
+ *
+ * @param[in] element_size The size of the data type to be stored in the list
+ * @param[in] capacity The initial capacity of the list (at least 1)
+ * @return A list_p (i.e. pointer to the list data type) to the created list
+ */
+list_p list_create_with_capacity(size_t element_size, int capacity);
+
+/**
+ * @brief create and initialise a new list using a custom allocator
+ *
+ * The list itself and its data array are allocated from alloc (see allocator.h),
+ * e.g. from an arena so that many short-lived lists can be freed at once.
+ * The allocator (and its context) must outlive the list.
+ *
+ * @param[in] element_size The size of the data type to be stored in the list
+ * @param[in] alloc The allocator (the function table is copied)
+ * @return A list_p (i.e. pointer to the list data type) to the created list
+ */
+list_p list_create_ex(size_t element_size, const allocator *alloc);
+
+/**
+ * @brief create and initialise a new unordered list (a bag)
+ *
+ * The same as list_create, except that list_remove does not keep the
+ * order of the items: the last item is moved into the removed item's
+ * place (see list_swap_remove), so removal takes constant time
+ * instead of shifting the rest of the list.
+ *
+ * @param[in] element_size The size of the data type to be stored in the list
+ * @return A list_p (i.e. pointer to the list data type) to the created list
+ */
+list_p list_create_unordered(size_t element_size);
+
+/**
+ * @brief create or reopen a list whose data array is a memory-mapped file
+ *
+ * If path does not exist, an empty list is created in a new file. If it
+ * is a list file (from an earlier list_create_mapped), the list is
+ * reopened with its items as of the last list_sync or list_delete;
+ * the items are paged in from the file as they are used, not read up front
+ * (list files have no checksum, unlike files from list_save).
+ *
+ * The file grows and shrinks with the list's capacity (by ftruncate and
+ * mremap), so the list can be larger than RAM and is never copied when
+ * it grows. All other list functions work as usual. The file is closed
+ * by list_delete.
+ *
+ * @param[in] path The path of the list file
+ * @param[in] element_size The size of the data type stored in the list
+ *                         (must match the file, when reopening)
+ * @return A list_p (i.e. pointer to the list data type), or NULL if the file
+ *         cannot be created or mapped, is not a list file of element_size items,
+ *         or holds more items than fit in an int
+ */
+list_p list_create_mapped(const char *path, size_t element_size);
+
+/**
+ * @brief Write a mapped list to its file (msync), so that it survives a crash
+ *
+ * Has no effect on lists which are not mapped.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @return 0 on success, -1 if the file could not be written
+ */
+int list_sync(list_p list);
+
+/**
+ * @brief Save the items of the list to a file
+ *
+ * The file has a short header (including the element size, the number
+ * of items and a checksum of the items) followed by the items as one
+ * block. It can be loaded with list_load or queue_load.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] path The path of the file (replaced if it exists)
+ * @return 0 on success, -1 if the file could not be written
+ */
+int list_save(list_p list, const char *path);
+
+/**
+ * @brief Load a list saved by list_save (or queue_save)
+ *
+ * The file is mapped (privately) and the list uses the items in place,
+ * so loading does not copy them. The whole file is still read once
+ * before list_load returns, to verify its checksum.
+ * Changes to the list are not written back to the file. The items are
+ * copied to the heap the first time the list's capacity changes.
+ *
+ * @param[in] path The path of the file
+ * @param[in] element_size The size of the data type stored in the list
+ *                         (must match the file)
+ * @return A list_p (i.e. pointer to the list data type), or NULL if the file
+ *         cannot be read, is not a saved file of element_size items,
+ *         or fails its checksum
+ */
+list_p list_load(const char *path, size_t element_size);
+
 /**
  * @brief append an item to the list
  * 
@@ -41,6 +172,22 @@ list_p list_create(size_t element_size);
 */
 void list_append(list_p list, void* value);
 
+/**
+ * @brief append count items to the list
+ *
+ * Equivalent to calling list_append for each item in turn, but the
+ * capacity is grown at most once and the items are copied in one block.
+ * Example usage to append the contents of an array of ints:
+ * list_append_n(my_list, my_array, 100);
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] src Pointer to the first of count consecutive values to be appended
+ * @param[in] count The number of values to be appended
+ * @param[out] list Updated list
+ * @return nothing
+*/
+void list_append_n(list_p list, const void *src, size_t count);
+
 /**
  * @brief insert an item in the list at the specified index
  * 
@@ -52,6 +199,22 @@ void list_append(list_p list, void* value);
 */
 void list_insert(list_p list, void* value, int index);
 
+/**
+ * @brief insert count items in the list starting at the specified index
+ *
+ * The items end up at indices index..index+count-1, in the same order as in src.
+ * The capacity is grown at most once and the existing items from index
+ * onwards are moved in one block.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] src Pointer to the first of count consecutive values to be inserted
+ * @param[in] count The number of values to be inserted
+ * @param[in] index The list index where the first item should be inserted
+ * @param[out] list Updated list
+ * @return nothing
+*/
+void list_insert_n(list_p list, const void *src, size_t count, int index);
+
 /**
  * @brief Get the current size (number of elements in use) of the list 
  * @param[in] list A pointer to an instance of the list_p data type
@@ -68,6 +231,43 @@ int list_size(list_p list);
 */
 void list_get(list_p list, int index, void *out);
 
+/**
+ * @brief get a read-only pointer to the item at the specified index
+ *
+ * Unlike list_get, the item is not copied. The pointer refers to the
+ * list's own storage, so it is only valid until the list is next changed
+ * by any function that adds or removes items (list_append, list_insert,
+ * list_remove and their bulk forms), or that changes the capacity
+ * (list_reserve, list_shrink_to_fit), or list_delete.
+ * Each of these may move the data array (see _resize) or shift items to
+ * different indices. list_set does not invalidate the pointer.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] index The list index of the item
+ * @return Pointer to the item at the specified index
+*/
+const void *list_at(list_p list, int index);
+
+/**
+ * @brief get the contiguous block of items held by the list
+ *
+ * The items are stored back to back (element_size bytes each) in index order,
+ * so a read-only scan can iterate without copying, e.g. for a list of ints:
+ * const void *data;
+ * int length;
+ * list_data_span(my_list, &data, &length);
+ * const int *items = data;
+ * for (int i = 0; i < length; i++) ... items[i] ...
+ *
+ * The same invalidation rules as for list_at apply to the returned pointer.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[out] data Pointer to the first item (may be to unused storage if length is 0)
+ * @param[out] length The number of items in the block (the list size)
+ * @return nothing
+*/
+void list_data_span(list_p list, const void **data, int *length);
+
 /**
  * @brief Set the value of the item at the specified index
  * @param[in] list A pointer to an instance of the list_p data type
@@ -80,6 +280,10 @@ void list_set(list_p list, void* value, int index);
 
 /**
  * @brief Remove the item at the specified list index
+ *
+ * The items after index are shifted one place to the left, unless the
+ * list was created with list_create_unordered (see list_swap_remove).
+ *
  * @param[in] list A pointer to an instance of the list_p data type
  * @param[in] index The list index of the item to remove
  * @param[out] list Updated data array in list->data, updated list->size
@@ -88,7 +292,385 @@ void list_set(list_p list, void* value, int index);
 void list_remove(list_p list, int index);
 
 /**
- * @brief Delete the list and free any memory allocated 
+ * @brief Remove every item for which predicate returns true
+ *
+ * The remaining items keep their order. Unlike calling list_remove for
+ * each item, the list is compacted in a single pass (so removing many
+ * items is linear, not quadratic) and the shrink policy is applied once
+ * at the end. predicate is called once for each item, in order.
+ *
+ * Example usage to remove the negative ints from a list:
+ * bool is_negative(const void *value, void *ctx) { return *(const int *)value < 0; }
+ * list_remove_if(my_list, is_negative, NULL);
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] predicate Function called with each item and ctx
+ * @param[in] ctx Pointer passed through to predicate
+ * @return The number of items removed
+*/
+int list_remove_if(list_p list, list_predicate_fn predicate, void *ctx);
+
+/**
+ * @brief Keep only the items for which predicate returns true
+ *
+ * The opposite of list_remove_if (with the same single compaction pass).
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] predicate Function called with each item and ctx
+ * @param[in] ctx Pointer passed through to predicate
+ * @return The number of items removed
+*/
+int list_retain(list_p list, list_predicate_fn predicate, void *ctx);
+
+/**
+ * @brief Remove the items from index from up to (but not including) index to
+ *
+ * The items after the range are moved down in a single block move,
+ * and the shrink policy is applied once.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] from The list index of the first item to remove
+ * @param[in] to The list index after the last item to remove (from <= to <= size)
+ * @return nothing
+*/
+void list_remove_range(list_p list, int from, int to);
+
+/**
+ * @brief Remove the item at the specified list index by moving the last
+ *        item into its place
+ *
+ * Removal takes constant time as nothing is shifted, but the order of
+ * the items is not kept. The shrink policy is applied as for list_remove.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] index The list index of the item to remove
+ * @return nothing
+*/
+void list_swap_remove(list_p list, int index);
+
+/**
+ * @brief Get the current capacity of the list
+ *
+ * The capacity is the number of items the list can hold before
+ * its data array has to grow.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @return An integer, the capacity of the list
+*/
+int list_capacity(list_p list);
+
+/**
+ * @brief Make sure the list can hold at least capacity items without growing
+ *
+ * The capacity is never reduced by this function.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] capacity The number of items the list must be able to hold
+ * @param[out] list Updated list->capacity
+ * @return nothing
+*/
+void list_reserve(list_p list, int capacity);
+
+/**
+ * @brief Reduce the capacity of the list to its current size
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[out] list Updated list->capacity
+ * @return nothing
+*/
+void list_shrink_to_fit(list_p list);
+
+/**
+ * @brief Set how the list grows when it is full
+ *
+ * By default the capacity doubles (factor 2, chunk 0).
+ * For very large lists, a fixed chunk avoids over-allocating by up to 2x.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] factor The factor by which the capacity is multiplied (> 1), used if chunk is 0
+ * @param[in] chunk If > 0, the number of items by which the capacity grows instead
+ * @return nothing
+*/
+void list_set_growth_policy(list_p list, double factor, int chunk);
+
+/**
+ * @brief Set how the list shrinks as items are removed
+ *
+ * When the size falls to capacity * threshold, the capacity is multiplied by factor.
+ * By default threshold is 0.25 and factor is 0.5. The gap between the two
+ * stops a list whose size oscillates from repeatedly shrinking and growing.
+ * Lists of up to 16 items never shrink.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] threshold Fraction of the capacity at which the list shrinks
+ *                      (0 disables shrinking, otherwise less than factor)
+ * @param[in] factor The factor by which the capacity is multiplied (less than 1)
+ * @return nothing
+*/
+void list_set_shrink_policy(list_p list, double threshold, double factor);
+
+/**
+ * @brief Get the operation statistics of the list
+ *
+ * The statistics are only kept when built with -DDS_STATS (``$ make STATS=1``),
+ * so that other builds pay nothing for them; otherwise they are all zero.
+ * They cover the life of the list, e.g. to show which lists cause
+ * memory churn, and how their capacity should be tuned.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[out] stats The statistics
+ * @return true if statistics are kept (built with DS_STATS)
+ */
+bool list_stats(list_p list, list_statistics *stats);
+
+/**
+ * @brief Set a function to be called each time the capacity of the list changes
+ *
+ * The function is called after the data array is resized, with the old and
+ * new capacities (e.g. to log them). This works in every build.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] trace The function (NULL to stop tracing)
+ * @param[in] ctx Pointer passed through to the function
+ * @return nothing
+ */
+void list_set_resize_trace(list_p list, list_resize_trace_fn trace, void *ctx);
+
+/**
+ * @brief Search the list for the first item equal to value
+ *
+ * Items are compared byte for byte (element_size bytes). For 4 and 8 byte
+ * items the search uses SSE2/AVX2 instructions where the CPU supports them.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to search for
+ * @return The index of the first matching item, or -1 if there is none
+*/
+int list_find(list_p list, const void *value);
+
+/**
+ * @brief Count the items in the list equal to value
+ *
+ * Items are compared as for list_find.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to count
+ * @return The number of matching items
+*/
+int list_count(list_p list, const void *value);
+
+/**
+ * @brief Set every item in the list to value
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to set
+ * @param[out] list Updated data array in list->data
+ * @return nothing
+*/
+void list_fill(list_p list, const void *value);
+
+/**
+ * @brief Sum of the items of an int32_t, int64_t, float or double list
+ *
+ * The list must have been created with the matching element size, e.g.
+ * list_create(sizeof(int32_t)) for list_sum_i32. int32_t items are summed
+ * in 64 bits. SSE2/AVX2 instructions are used where the CPU supports them,
+ * so float and double sums may differ from a sequential sum by rounding.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @return The sum of the items (0 for an empty list)
+*/
+int64_t list_sum_i32(list_p list);
+int64_t list_sum_i64(list_p list);
+float list_sum_f32(list_p list);
+double list_sum_f64(list_p list);
+
+/**
+ * @brief Minimum/maximum of the items of an int32_t, int64_t, float or double list
+ *
+ * The list must have been created with the matching element size and must
+ * not be empty. The result is unspecified if a float/double list contains NaNs.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @return The minimum/maximum item
+*/
+int32_t list_min_i32(list_p list);
+int32_t list_max_i32(list_p list);
+int64_t list_min_i64(list_p list);
+int64_t list_max_i64(list_p list);
+float list_min_f32(list_p list);
+float list_max_f32(list_p list);
+double list_min_f64(list_p list);
+double list_max_f64(list_p list);
+
+/**
+ * @brief Comparison function for list_sort and list_stable_sort
+ *
+ * As for qsort: returns a negative value if a sorts before b, zero if
+ * they are equal and a positive value if a sorts after b.
+ */
+typedef int (*list_compare_fn)(const void *a, const void *b);
+
+/**
+ * @brief Element types understood by list_radix_sort
+ */
+typedef enum list_key_type
+{
+  LIST_KEY_I32 = 0,
+  LIST_KEY_U32,
+  LIST_KEY_F32,
+  LIST_KEY_I64,
+  LIST_KEY_U64,
+  LIST_KEY_F64
+} list_key_type;
+
+/**
+ * @brief Sort the list in place
+ *
+ * The order of equal items is unspecified. Large lists are sorted by
+ * several threads (one per online CPU): each sorts a chunk and the chunks
+ * are then merged. A temporary buffer the size of the list is used.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] cmp The comparison function
+ * @return nothing
+*/
+void list_sort(list_p list, list_compare_fn cmp);
+
+/**
+ * @brief Sort the list in place, keeping equal items in their original order
+ *
+ * A merge sort, which is multi-threaded for large lists as for list_sort.
+ * A temporary buffer the size of the list is used.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] cmp The comparison function
+ * @return nothing
+*/
+void list_stable_sort(list_p list, list_compare_fn cmp);
+
+/**
+ * @brief Sort a list of 32 or 64 bit integers or floating point numbers
+ *        into ascending order with a radix sort
+ *
+ * The list must have been created with the element size of type (e.g.
+ * sizeof(float) for LIST_KEY_F32). The sort is stable and does not call a
+ * comparison function. Floating point values are ordered by their bits
+ * (so -0.0 sorts before 0.0, and NaNs sort to the ends by sign).
+ * A temporary buffer the size of the list is used.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] type The type of the items
+ * @return nothing
+*/
+void list_radix_sort(list_p list, list_key_type type);
+
+/**
+ * @brief Find the first item which is not less than value
+ *
+ * The list must be sorted by cmp. Uses a binary search.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to search for
+ * @param[in] cmp The comparison function (called as cmp(item, value))
+ * @return The index of the first item >= value (the list size if there is none)
+*/
+int list_lower_bound(list_p list, const void *value, list_compare_fn cmp);
+
+/**
+ * @brief Find the first item which is greater than value
+ *
+ * The list must be sorted by cmp. Uses a binary search.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to search for
+ * @param[in] cmp The comparison function (called as cmp(item, value))
+ * @return The index of the first item > value (the list size if there is none)
+*/
+int list_upper_bound(list_p list, const void *value, list_compare_fn cmp);
+
+/**
+ * @brief Find an item equal to value in a sorted list
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to search for
+ * @param[in] cmp The comparison function (called as cmp(item, value))
+ * @return The index of the first equal item, or -1 if there is none
+*/
+int list_binary_search(list_p list, const void *value, list_compare_fn cmp);
+
+/**
+ * @brief Insert a value into a sorted list, keeping it sorted
+ *
+ * The value is inserted after any equal items (as for list_insert).
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to insert
+ * @param[in] cmp The comparison function
+ * @return The index at which the value was inserted
+*/
+int list_insert_sorted(list_p list, void *value, list_compare_fn cmp);
+
+/**
+ * @brief Find the first item which is not less than value, without branching
+ *        on the comparison results
+ *
+ * Gives the same result as list_lower_bound. The search always takes
+ * log2(size) steps and chooses each half with a conditional move rather
+ * than a branch, which avoids branch mispredictions on random lookups.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type
+ * @param[in] value Pointer to the value to search for
+ * @param[in] cmp The comparison function (called as cmp(item, value))
+ * @return The index of the first item >= value (the list size if there is none)
+*/
+int list_lower_bound_branchless(list_p list, const void *value, list_compare_fn cmp);
+
+/**
+ * @brief Data type representing a read-only search index over a sorted list
+ *
+ * The index holds a copy of the items in Eytzinger (breadth-first binary
+ * tree) order, so that the first levels of every search share a few cache
+ * lines and the next levels can be prefetched. It suits large lists which
+ * are searched much more often than they change.
+ */
+typedef struct list_eytzinger *list_eytzinger_p;
+
+/**
+ * @brief Build an Eytzinger search index over a sorted list
+ *
+ * The index is a copy: it does not see later changes to the list, and
+ * must be rebuilt after the list changes.
+ *
+ * @param[in] list A pointer to an instance of the list_p data type (sorted by cmp)
+ * @param[in] cmp The comparison function (called as cmp(item, value))
+ * @return A list_eytzinger_p (i.e. pointer to the index)
+*/
+list_eytzinger_p list_eytzinger_create(list_p list, list_compare_fn cmp);
+
+/**
+ * @brief Find the first item which is not less than value using the index
+ *
+ * @param[in] index A pointer to an instance of the list_eytzinger_p data type
+ * @param[in] value Pointer to the value to search for
+ * @return The list index of the first item >= value (the list size when
+ *         the index was built, if there is none)
+*/
+int list_eytzinger_lower_bound(list_eytzinger_p index, const void *value);
+
+/**
+ * @brief Delete the search index and free any memory allocated
+ * @param[in] index A pointer to an instance of the list_eytzinger_p data type
+ * @return Nothing
+*/
+void list_eytzinger_delete(list_eytzinger_p index);
+
+/**
+ * @brief Delete the list and free any memory allocated
+ *
+ * For a mapped list, the size of the list is saved to the file and the
+ * file is unmapped and closed (the items are already in the file; use
+ * list_sync to also flush them to disk).
  * @param[in] list A pointer to an instance of the list_p data type
  * @return Nothing
 */
@@ -0,0 +1,66 @@
+/**
+ * array_list_io.c
+ *
+ * Implementation of saving and loading lists for the array_list module
+ * (see serialize.c for the file format)
+ *
+ * @author ruairin
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "array_list_p.h"
+#include "serialize_p.h"
+
+/*
+Saves the items of the list to a file
+
+Inputs:
+  list - pointer to an instance of the list type
+  path - the path of the file (replaced if it exists)
+
+Returns:
+  0 on success, -1 if the file could not be written
+
+*/
+int list_save(list_p list, const char *path)
+{
+  FILE *file = _serial_begin(path);
+  if (file == NULL)
+    return -1;
+
+  size_t bytes = (size_t)list->size * list->element_size;
+  uint64_t checksum = _checksum(CHECKSUM_SEED, list->data, bytes);
+  if (bytes > 0 && fwrite(list->data, 1, bytes, file) != bytes)
+  {
+    fclose(file);
+    return -1;
+  }
+  return _serial_end(file, list->element_size, list->size, checksum);
+}
+
+/*
+Loads a list saved by list_save or queue_save.
+The list adopts the items in the (private) mapping of the file
+
+Inputs:
+  path - the path of the file
+  element_size - the size of the primitive data type stored in the list
+
+Returns:
+  A list_p (pointer to the list), or NULL if the file cannot be read
+  or is not valid
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+list_p list_load(const char *path, size_t element_size)
+{
+  size_t length, count;
+  char *map = _serial_map(path, element_size, &length, &count);
+  if (map == NULL)
+    return NULL;
+
+  return _adopt_mapping(-1, map, length, SERIAL_HEADER_SIZE, element_size, (int)count, (int)count);
+}
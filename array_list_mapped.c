@@ -0,0 +1,280 @@
+/**
+ * array_list_mapped.c
+ *
+ * Implementation of file-backed (memory-mapped) lists
+ * for the array_list module
+ *
+ * The data array of a mapped list is a shared mapping of a file, so it
+ * is paged in and out by the kernel rather than held in the heap. The
+ * file starts with a header page (see struct _mapped_header) followed by
+ * capacity items. The capacity follows the list's growth and shrink
+ * policy as usual, but each resize changes the file length (ftruncate)
+ * and remaps it (mremap), which lets the kernel move the mapping without
+ * copying the data.
+ *
+ * Lists loaded by list_load (array_list_io.c) are also mapped, but
+ * privately and without the file kept open (fd is -1), so changes are not
+ * written back. Such a list is moved to the heap when it is first resized.
+ *
+ * @author ruairin
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "array_list_p.h"
+
+// The items start one page into the file, so the data array is page aligned
+#define HEADER_SIZE 4096
+
+#define MAPPED_MAGIC "DSLIST\0\0"
+#define MAPPED_VERSION 1
+
+// The capacity of a new mapped list (one page of data for 4 byte items)
+#define MAPPED_INITIAL_CAPACITY 1024
+
+/*
+The header at the start of a list file.
+size is only brought up to date by list_sync and list_delete
+*/
+struct _mapped_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t element_size;
+  uint64_t size;
+};
+
+/*
+The file of a mapped list. The whole file is mapped at map
+(a header of offset bytes, then the list's data array)
+*/
+struct _list_mapping
+{
+  int fd;        // -1 for a private mapping (from list_load)
+  char *map;
+  size_t length; // bytes mapped (the file length)
+  size_t offset; // bytes before the data array
+};
+
+/*
+Creates a list in a new file, or reopens an existing list file
+
+Inputs:
+  path - the path of the list file
+  element_size - the size of the primitive data type stored in the list
+
+Returns:
+  A list_p (pointer to the list), or NULL if the file cannot be
+  created or mapped, is not a list file of element_size items, or
+  holds more items than fit in an int
+
+Throws:
+  aborts if element_size is zero or if the memory allocations fail
+
+*/
+list_p list_create_mapped(const char *path, size_t element_size)
+{
+  assert(element_size > 0 && "Error: Element size must be positive");
+
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  bool is_new = (st.st_size == 0);
+  size_t length = is_new ? HEADER_SIZE + MAPPED_INITIAL_CAPACITY * element_size : (size_t)st.st_size;
+  if (length < HEADER_SIZE || (is_new && ftruncate(fd, length) != 0))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  char *map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  struct _mapped_header *header = (struct _mapped_header *)map;
+  if (is_new)
+  {
+    memcpy(header->magic, MAPPED_MAGIC, sizeof(header->magic));
+    header->version = MAPPED_VERSION;
+    header->reserved = 0;
+    header->element_size = element_size;
+    header->size = 0;
+  }
+  else if (memcmp(header->magic, MAPPED_MAGIC, sizeof(header->magic)) != 0 ||
+           header->version != MAPPED_VERSION || header->element_size != element_size ||
+           header->size > (length - HEADER_SIZE) / element_size ||
+           (length - HEADER_SIZE) / element_size > INT32_MAX)
+  {
+    munmap(map, length);
+    close(fd);
+    return NULL;
+  }
+
+  int capacity = (int)((length - HEADER_SIZE) / element_size);
+  return _adopt_mapping(fd, map, length, HEADER_SIZE, element_size, capacity, (int)header->size);
+}
+
+/*
+Writes a mapped list (its size and items) to its file
+
+Inputs:
+  list - pointer to an instance of the list type
+
+Returns:
+  0 on success (or if the list is not mapped to a file)
+  -1 if the file could not be written
+
+*/
+int list_sync(list_p list)
+{
+  if (list->mapping == NULL || list->mapping->fd < 0)
+    return 0;
+
+  struct _mapped_header *header = (struct _mapped_header *)list->mapping->map;
+  header->size = list->size;
+  return msync(list->mapping->map, list->mapping->length, MS_SYNC);
+}
+
+/*
+Internal function to create a list whose data array is in a mapping
+
+Inputs:
+  fd - the open file of the mapping (-1 for a private mapping)
+  map - the mapping
+  length - the length of the mapping
+  offset - the bytes before the data array in the mapping
+  element_size - the size of the primitive data type stored in the list
+  capacity - the number of items which fit in the mapping
+  size - the number of items in the list
+
+Returns:
+  A list_p (pointer to the list), which owns the mapping
+
+Throws:
+  aborts if the memory allocations fail
+*/
+list_p _adopt_mapping(int fd, char *map, size_t length, size_t offset,
+                      size_t element_size, int capacity, int size)
+{
+  // Create a heap list, then swap its data array for the mapping
+  list_p list = list_create(element_size);
+  list->alloc.free(list->alloc.ctx, list->data, list->capacity * list->element_size);
+
+  list->mapping = malloc(sizeof(struct _list_mapping));
+  assert(list->mapping != NULL && "Error in memory allocation");
+  list->mapping->fd = fd;
+  list->mapping->map = map;
+  list->mapping->length = length;
+  list->mapping->offset = offset;
+  list->data = map + offset;
+  list->capacity = capacity;
+  list->stats.peak_capacity = capacity;
+  list->size = size;
+  return list;
+}
+
+/*
+Internal function to resize the data array of a mapped list, by
+resizing the file and remapping it (the kernel may move the mapping,
+but does not copy the data).
+A privately mapped list is instead copied to a heap array, and unmapped
+
+Inputs:
+  list - pointer to an instance of the list type (mapped)
+  capacity - the new capacity for the list->data array
+
+Outputs:
+  list - list->data in the new mapping, updated list->capacity
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the file cannot be resized or remapped
+*/
+void _resize_mapped(list_p list, int capacity)
+{
+  struct _list_mapping *mapping = list->mapping;
+  if (mapping->fd < 0)
+  {
+    char *data = list->alloc.alloc(list->alloc.ctx, (size_t)capacity * list->element_size);
+    assert(data != NULL && "Error in memory allocation");
+    int size = list->size < capacity ? list->size : capacity;
+    memcpy(data, list->data, (size_t)size * list->element_size);
+    _unmap_list(list);
+    list->data = data;
+    list->capacity = capacity;
+    return;
+  }
+
+  size_t length = mapping->offset + (size_t)capacity * list->element_size;
+
+  // Grow the file before the mapping, and shrink it after
+  if (length > mapping->length)
+  {
+    int grown = ftruncate(mapping->fd, length);
+    assert(grown == 0 && "Error: Cannot grow list file");
+  }
+
+  char *map = mremap(mapping->map, mapping->length, length, MREMAP_MAYMOVE);
+  assert(map != MAP_FAILED && "Error: Cannot remap list file");
+
+  if (length < mapping->length)
+  {
+    int shrunk = ftruncate(mapping->fd, length);
+    assert(shrunk == 0 && "Error: Cannot shrink list file");
+  }
+
+  mapping->map = map;
+  mapping->length = length;
+  list->data = map + mapping->offset;
+  list->capacity = capacity;
+}
+
+/*
+Internal function to save the size of a mapped list to its file, then
+unmap and close the file (called by list_delete).
+A privately mapped list is just unmapped
+
+Inputs:
+  list - pointer to an instance of the list type (mapped)
+
+Returns:
+  Nothing
+
+*/
+void _unmap_list(list_p list)
+{
+  struct _list_mapping *mapping = list->mapping;
+  if (mapping->fd >= 0)
+  {
+    struct _mapped_header *header = (struct _mapped_header *)mapping->map;
+    header->size = list->size;
+  }
+
+  munmap(mapping->map, mapping->length);
+  if (mapping->fd >= 0)
+    close(mapping->fd);
+  free(mapping);
+  list->mapping = NULL;
+  list->data = NULL;
+}
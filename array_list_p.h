@@ -9,17 +9,61 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include "array_list.h"
+#include "allocator.h"
 
 #ifndef ARRAY_LIST_P
 #define ARRAY_LIST_P
 
+/*
+The list data type for the array_list module
+Data is a char because pointer arithmetic is used
+*/
+typedef struct list
+{
+  char *data;
+  int size;
+  int capacity;
+  size_t element_size;
+  allocator alloc;         // source of the memory for the list and its data array
+  double grow_factor;      // capacity multiplier when full (if grow_chunk is 0)
+  int grow_chunk;          // if > 0, the capacity grows by this many elements instead
+  double shrink_threshold; // shrink when size <= capacity * shrink_threshold (0 never shrinks)
+  double shrink_factor;    // capacity multiplier when shrinking
+  struct _list_mapping *mapping; // the file of a mapped list (NULL if not mapped)
+  list_statistics stats;         // only updated when built with DS_STATS
+  list_resize_trace_fn resize_trace; // called after each resize (if not NULL)
+  void *resize_trace_ctx;
+  bool unordered;                // list_remove moves the last item into the hole
+} *list_p;
+
+/*
+Updates a statistic of the list (only when built with DS_STATS)
+*/
+#ifdef DS_STATS
+#define LIST_STAT(statement) statement
+#else
+#define LIST_STAT(statement)
+#endif
+
+list_p _list_create(size_t element_size, int capacity, const allocator *alloc);
 bool _is_index_outside_bounds(int size, int index);
 bool _is_list_full(list_p list);
 bool _is_list_too_empty(list_p list);
 void _grow_array(list_p list);
+int _grown_capacity(list_p list, int capacity);
+void _ensure_capacity(list_p list, int required);
 void _shrink_array(list_p list);
+void _shrink_after_removal(list_p list);
+int _compact(list_p list, list_predicate_fn predicate, void *ctx, bool remove_matching);
 void _resize(list_p list, int capacity);
 void* _data_ptr(list_p list, int index);
 
+// File-backed lists (array_list_mapped.c)
+list_p _adopt_mapping(int fd, char *map, size_t length, size_t offset,
+                      size_t element_size, int capacity, int size);
+void _resize_mapped(list_p list, int capacity);
+void _unmap_list(list_p list);
+
 #endif
\ No newline at end of file
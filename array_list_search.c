@@ -0,0 +1,280 @@
+/**
+ * array_list_search.c
+ *
+ * Implementation of the binary search functions for the array_list module
+ *
+ * These functions work directly on the contiguous list->data array of
+ * a list sorted by the caller's comparison function.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "array_list_search_p.h"
+
+// How many tree levels ahead list_eytzinger_lower_bound prefetches.
+// The 2^PREFETCH_LEVELS descendants of a node are consecutive
+#define PREFETCH_LEVELS 4
+
+/*
+The Eytzinger search index. The items are stored 1-based in breadth-first
+order of a complete binary search tree: the children of node k are 2k
+and 2k + 1. positions maps each node back to its index in the list
+Data is a char because pointer arithmetic is used
+*/
+typedef struct list_eytzinger
+{
+  char *data;     // size + 1 items (node 0 is unused)
+  int *positions; // list index of each node
+  int size;
+  size_t element_size;
+  list_compare_fn cmp;
+} *list_eytzinger_p;
+
+/*
+Finds the first item which is not less than value
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  value - pointer to the value to search for
+  cmp - the comparison function
+
+Returns:
+  The index of the first item >= value (list->size if there is none)
+
+*/
+int list_lower_bound(list_p list, const void *value, list_compare_fn cmp)
+{
+  int low = 0;
+  int high = list->size;
+  while (low < high)
+  {
+    int middle = low + (high - low) / 2;
+    if (cmp(_data_ptr(list, middle), value) < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+/*
+Finds the first item which is greater than value
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  value - pointer to the value to search for
+  cmp - the comparison function
+
+Returns:
+  The index of the first item > value (list->size if there is none)
+
+*/
+int list_upper_bound(list_p list, const void *value, list_compare_fn cmp)
+{
+  int low = 0;
+  int high = list->size;
+  while (low < high)
+  {
+    int middle = low + (high - low) / 2;
+    if (cmp(_data_ptr(list, middle), value) <= 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+/*
+Finds an item equal to value
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  value - pointer to the value to search for
+  cmp - the comparison function
+
+Returns:
+  The index of the first equal item, or -1 if there is none
+
+*/
+int list_binary_search(list_p list, const void *value, list_compare_fn cmp)
+{
+  int index = list_lower_bound(list, value, cmp);
+  if (index < list->size && cmp(_data_ptr(list, index), value) == 0)
+    return index;
+  return -1;
+}
+
+/*
+Inserts a value after any equal items in a sorted list
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  value - pointer to the value to insert
+  cmp - the comparison function
+
+Returns:
+  The index at which the value was inserted
+
+Throws:
+  aborts on memory allocation error
+
+*/
+int list_insert_sorted(list_p list, void *value, list_compare_fn cmp)
+{
+  int index = list_upper_bound(list, value, cmp);
+  if (index == list->size)
+    list_append(list, value);
+  else
+    list_insert(list, value, index);
+  return index;
+}
+
+/*
+Finds the first item which is not less than value, choosing each
+half with a conditional move. base is the start of the range still
+being searched; after the loop the answer is base or the item after it.
+As the next step does not depend on a branch, both of its possible
+middles can be prefetched
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  value - pointer to the value to search for
+  cmp - the comparison function
+
+Returns:
+  The index of the first item >= value (list->size if there is none)
+
+*/
+int list_lower_bound_branchless(list_p list, const void *value, list_compare_fn cmp)
+{
+  if (list->size == 0)
+    return 0;
+
+  const char *base = list->data;
+  size_t element_size = list->element_size;
+  int n = list->size;
+  while (n > 1)
+  {
+    int half = n / 2;
+    const char *middle = base + (size_t)half * element_size;
+    // Prefetch both possible middles of the next step
+    __builtin_prefetch(base + (size_t)(half / 2) * element_size);
+    __builtin_prefetch(middle + (size_t)(half / 2) * element_size);
+    base = (cmp(middle, value) < 0) ? middle : base;
+    n -= half;
+  }
+  int index = (int)((base - list->data) / element_size);
+  return index + (cmp(base, value) < 0);
+}
+
+/*
+Builds an Eytzinger search index over a sorted list
+
+Inputs:
+  list - pointer to an instance of the list type (sorted by cmp)
+  cmp - the comparison function
+
+Returns:
+  A list_eytzinger_p (pointer to the newly created index)
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+list_eytzinger_p list_eytzinger_create(list_p list, list_compare_fn cmp)
+{
+  list_eytzinger_p index;
+  index = (list_eytzinger_p)malloc(sizeof(struct list_eytzinger));
+  assert(index != NULL && "Error in memory allocation");
+
+  index->size = list->size;
+  index->element_size = list->element_size;
+  index->cmp = cmp;
+  index->data = malloc((size_t)(list->size + 1) * list->element_size);
+  index->positions = malloc((size_t)(list->size + 1) * sizeof(int));
+  assert(index->data != NULL && index->positions != NULL && "Error in memory allocation");
+
+  _eytzinger_fill(index, list, 0, 1);
+  // Node 0 is the "not found" result
+  index->positions[0] = list->size;
+  return index;
+}
+
+/*
+Finds the first item which is not less than value using the index.
+The search descends from the root, going right while the node is less
+than value; the answer is the last node where it went left, which is
+recovered from the path by removing the trailing right turns
+
+Inputs:
+  index - pointer to an instance of the eytzinger index type
+  value - pointer to the value to search for
+
+Returns:
+  The list index of the first item >= value (the list size if there is none)
+
+*/
+int list_eytzinger_lower_bound(list_eytzinger_p index, const void *value)
+{
+  const char *data = index->data;
+  size_t element_size = index->element_size;
+  unsigned long k = 1;
+  while (k <= (unsigned long)index->size)
+  {
+    __builtin_prefetch(data + (k << PREFETCH_LEVELS) * element_size);
+    k = 2 * k + (index->cmp(data + k * element_size, value) < 0);
+  }
+  // Drop the trailing 1 bits (right turns) and the last left turn
+  k >>= __builtin_ctzl(~k) + 1;
+  return index->positions[k];
+}
+
+/*
+Frees the memory allocated to the index
+
+Inputs:
+  index - pointer to an instance of the eytzinger index type
+
+Returns:
+  Nothing
+
+*/
+void list_eytzinger_delete(list_eytzinger_p index)
+{
+  if (index)
+  {
+    free(index->data);
+    free(index->positions);
+    free(index);
+  }
+}
+
+/*
+Internal function to copy the list items into the index in tree order.
+An in-order walk of the tree visits the nodes in sorted order
+
+Inputs:
+  index - pointer to an instance of the eytzinger index type
+  list - pointer to an instance of the list type
+  position - the list index of the next item to place
+  k - the tree node to fill
+
+Returns:
+  The list index of the next item to place after the subtree of k
+
+*/
+int _eytzinger_fill(list_eytzinger_p index, list_p list, int position, int k)
+{
+  if (k <= index->size)
+  {
+    position = _eytzinger_fill(index, list, position, 2 * k);
+    memcpy(index->data + (size_t)k * index->element_size, _data_ptr(list, position), index->element_size);
+    index->positions[k] = position;
+    position++;
+    position = _eytzinger_fill(index, list, position, 2 * k + 1);
+  }
+  return position;
+}
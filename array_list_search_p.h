@@ -0,0 +1,18 @@
+/**
+ * array_list_search_p.h
+ *
+ * Private header file for the binary search functions
+ * of the array_list module (array_list_search.c)
+ *
+ * @author ruairin
+ *
+ */
+
+#include "array_list_p.h"
+
+#ifndef ARRAY_LIST_SEARCH_P
+#define ARRAY_LIST_SEARCH_P
+
+int _eytzinger_fill(list_eytzinger_p index, list_p list, int position, int k);
+
+#endif
@@ -0,0 +1,1026 @@
+/**
+ * array_list_simd.c
+ *
+ * Implementation of the search, fill and reduction functions
+ * for the array_list module
+ *
+ * These functions work directly on the contiguous list->data array.
+ * For 4 and 8 byte elements, the searches and the numeric reductions use
+ * SSE2 or AVX2 kernels. The instruction set is chosen once at runtime from
+ * the CPU features (see _simd_level), with a scalar fallback for other
+ * CPUs and element sizes.
+ *
+ * @author ruairin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "array_list_simd_p.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+// Sentinel for a level that has not been detected yet
+#define SIMD_UNKNOWN -1
+
+// Atomic, as the first calls may come from several threads at once
+// (relaxed is enough: every thread detects the same level)
+static _Atomic int simd_level = SIMD_UNKNOWN;
+
+/*
+Searches the list for the first item equal (byte for byte) to value
+
+Inputs:
+  list - pointer to an instance of the list type
+  value - pointer to the value to search for
+
+Returns:
+  The index of the first matching item, or -1 if there is none
+
+*/
+int list_find(list_p list, const void *value)
+{
+  if (list->element_size == sizeof(uint32_t))
+  {
+    uint32_t key;
+    memcpy(&key, value, sizeof(key));
+    return _find_32((const uint32_t *)list->data, list->size, key);
+  }
+  if (list->element_size == sizeof(uint64_t))
+  {
+    uint64_t key;
+    memcpy(&key, value, sizeof(key));
+    return _find_64((const uint64_t *)list->data, list->size, key);
+  }
+
+  for (int i = 0; i < list->size; i++)
+  {
+    if (memcmp(_data_ptr(list, i), value, list->element_size) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/*
+Counts the items in the list equal (byte for byte) to value
+
+Inputs:
+  list - pointer to an instance of the list type
+  value - pointer to the value to count
+
+Returns:
+  The number of matching items
+
+*/
+int list_count(list_p list, const void *value)
+{
+  if (list->element_size == sizeof(uint32_t))
+  {
+    uint32_t key;
+    memcpy(&key, value, sizeof(key));
+    return _count_32((const uint32_t *)list->data, list->size, key);
+  }
+  if (list->element_size == sizeof(uint64_t))
+  {
+    uint64_t key;
+    memcpy(&key, value, sizeof(key));
+    return _count_64((const uint64_t *)list->data, list->size, key);
+  }
+
+  int count = 0;
+  for (int i = 0; i < list->size; i++)
+  {
+    if (memcmp(_data_ptr(list, i), value, list->element_size) == 0)
+      count++;
+  }
+  return count;
+}
+
+/*
+Sets every item in the list to value.
+The first item is set, then the filled part is repeatedly copied
+onto the rest, doubling each time, so the work is done by a
+logarithmic number of (large, vectorised) memcpy calls for any element size
+
+Inputs:
+  list - pointer to an instance of the list type
+  value - pointer to the value to set
+
+Outputs:
+  list - updated list->data array
+
+Returns:
+  Nothing
+
+*/
+void list_fill(list_p list, const void *value)
+{
+  if (list->size == 0)
+    return;
+
+  size_t total = (size_t)list->size * list->element_size;
+  size_t filled = list->element_size;
+  memcpy(list->data, value, list->element_size);
+
+  while (filled < total)
+  {
+    size_t chunk = filled < total - filled ? filled : total - filled;
+    memcpy(list->data + filled, list->data, chunk);
+    filled += chunk;
+  }
+}
+
+/*
+Numeric reductions over lists of int32_t, int64_t, float and double.
+The sum of an int32_t list is accumulated in 64 bits. Sums of float and
+double lists may differ from a sequential sum by rounding, as the
+vector kernels add in a different order. The result of min/max is
+unspecified if the list contains NaNs
+
+Inputs:
+  list - pointer to an instance of the list type
+
+Returns:
+  The sum, minimum or maximum of the items
+
+Throws:
+  aborts if the element size of the list does not match the type,
+  or for min/max, if the list is empty
+
+*/
+int64_t list_sum_i32(list_p list)
+{
+  assert(list->element_size == sizeof(int32_t) && "Error: list does not hold int32_t");
+  return _sum_i32((const int32_t *)list->data, list->size);
+}
+
+int64_t list_sum_i64(list_p list)
+{
+  assert(list->element_size == sizeof(int64_t) && "Error: list does not hold int64_t");
+  return _sum_i64((const int64_t *)list->data, list->size);
+}
+
+float list_sum_f32(list_p list)
+{
+  assert(list->element_size == sizeof(float) && "Error: list does not hold float");
+  return _sum_f32((const float *)list->data, list->size);
+}
+
+double list_sum_f64(list_p list)
+{
+  assert(list->element_size == sizeof(double) && "Error: list does not hold double");
+  return _sum_f64((const double *)list->data, list->size);
+}
+
+int32_t list_min_i32(list_p list)
+{
+  assert(list->element_size == sizeof(int32_t) && "Error: list does not hold int32_t");
+  assert(list->size > 0 && "Error: min of empty list");
+  return _extreme_i32((const int32_t *)list->data, list->size, false);
+}
+
+int32_t list_max_i32(list_p list)
+{
+  assert(list->element_size == sizeof(int32_t) && "Error: list does not hold int32_t");
+  assert(list->size > 0 && "Error: max of empty list");
+  return _extreme_i32((const int32_t *)list->data, list->size, true);
+}
+
+int64_t list_min_i64(list_p list)
+{
+  assert(list->element_size == sizeof(int64_t) && "Error: list does not hold int64_t");
+  assert(list->size > 0 && "Error: min of empty list");
+  return _extreme_i64((const int64_t *)list->data, list->size, false);
+}
+
+int64_t list_max_i64(list_p list)
+{
+  assert(list->element_size == sizeof(int64_t) && "Error: list does not hold int64_t");
+  assert(list->size > 0 && "Error: max of empty list");
+  return _extreme_i64((const int64_t *)list->data, list->size, true);
+}
+
+float list_min_f32(list_p list)
+{
+  assert(list->element_size == sizeof(float) && "Error: list does not hold float");
+  assert(list->size > 0 && "Error: min of empty list");
+  return _extreme_f32((const float *)list->data, list->size, false);
+}
+
+float list_max_f32(list_p list)
+{
+  assert(list->element_size == sizeof(float) && "Error: list does not hold float");
+  assert(list->size > 0 && "Error: max of empty list");
+  return _extreme_f32((const float *)list->data, list->size, true);
+}
+
+double list_min_f64(list_p list)
+{
+  assert(list->element_size == sizeof(double) && "Error: list does not hold double");
+  assert(list->size > 0 && "Error: min of empty list");
+  return _extreme_f64((const double *)list->data, list->size, false);
+}
+
+double list_max_f64(list_p list)
+{
+  assert(list->element_size == sizeof(double) && "Error: list does not hold double");
+  assert(list->size > 0 && "Error: max of empty list");
+  return _extreme_f64((const double *)list->data, list->size, true);
+}
+
+/*
+Internal function to get the instruction set used by the kernels.
+On first use this is the best level supported by the CPU
+
+Returns:
+  The current level
+
+*/
+_simd_level_t _simd_level(void)
+{
+  int level = atomic_load_explicit(&simd_level, memory_order_relaxed);
+  if (level == SIMD_UNKNOWN)
+  {
+    level = _simd_max_level();
+    atomic_store_explicit(&simd_level, level, memory_order_relaxed);
+  }
+  return (_simd_level_t)level;
+}
+
+/*
+Internal function to detect the best instruction set supported by the CPU
+
+Returns:
+  SIMD_AVX2, SIMD_SSE2 or SIMD_SCALAR
+
+*/
+_simd_level_t _simd_max_level(void)
+{
+#if SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return SIMD_AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return SIMD_SSE2;
+#endif
+  return SIMD_SCALAR;
+}
+
+/*
+Internal function to override the instruction set used by the kernels
+(for tests and benchmarks). Levels the CPU does not support are
+reduced to the best supported level
+
+Inputs:
+  level - the requested level
+
+Returns:
+  Nothing
+
+*/
+void _simd_set_level(_simd_level_t level)
+{
+  _simd_level_t max_level = _simd_max_level();
+  atomic_store_explicit(&simd_level, level > max_level ? max_level : level, memory_order_relaxed);
+}
+
+/*
+Scalar kernels
+
+Inputs:
+  data - pointer to the first element
+  n - the number of elements (at least 1 for the _extreme kernels)
+  key - the value to search for (_find and _count)
+  max - true for the maximum, false for the minimum (_extreme)
+
+Returns:
+  _find: the index of the first element equal to key, or -1
+  _count: the number of elements equal to key
+  _sum: the sum of the elements
+  _extreme: the minimum or maximum element
+
+*/
+int _find_32_scalar(const uint32_t *data, int n, uint32_t key)
+{
+  for (int i = 0; i < n; i++)
+  {
+    if (data[i] == key)
+      return i;
+  }
+  return -1;
+}
+
+int _find_64_scalar(const uint64_t *data, int n, uint64_t key)
+{
+  for (int i = 0; i < n; i++)
+  {
+    if (data[i] == key)
+      return i;
+  }
+  return -1;
+}
+
+int _count_32_scalar(const uint32_t *data, int n, uint32_t key)
+{
+  int count = 0;
+  for (int i = 0; i < n; i++)
+    count += (data[i] == key);
+  return count;
+}
+
+int _count_64_scalar(const uint64_t *data, int n, uint64_t key)
+{
+  int count = 0;
+  for (int i = 0; i < n; i++)
+    count += (data[i] == key);
+  return count;
+}
+
+int64_t _sum_i32_scalar(const int32_t *data, int n)
+{
+  int64_t sum = 0;
+  for (int i = 0; i < n; i++)
+    sum += data[i];
+  return sum;
+}
+
+int64_t _sum_i64_scalar(const int64_t *data, int n)
+{
+  // Unsigned arithmetic so that overflow wraps as it does in the vector kernels
+  uint64_t sum = 0;
+  for (int i = 0; i < n; i++)
+    sum += (uint64_t)data[i];
+  return (int64_t)sum;
+}
+
+float _sum_f32_scalar(const float *data, int n)
+{
+  float sum = 0;
+  for (int i = 0; i < n; i++)
+    sum += data[i];
+  return sum;
+}
+
+double _sum_f64_scalar(const double *data, int n)
+{
+  double sum = 0;
+  for (int i = 0; i < n; i++)
+    sum += data[i];
+  return sum;
+}
+
+int32_t _extreme_i32_scalar(const int32_t *data, int n, bool max)
+{
+  int32_t result = data[0];
+  for (int i = 1; i < n; i++)
+  {
+    if (max ? data[i] > result : data[i] < result)
+      result = data[i];
+  }
+  return result;
+}
+
+int64_t _extreme_i64_scalar(const int64_t *data, int n, bool max)
+{
+  int64_t result = data[0];
+  for (int i = 1; i < n; i++)
+  {
+    if (max ? data[i] > result : data[i] < result)
+      result = data[i];
+  }
+  return result;
+}
+
+float _extreme_f32_scalar(const float *data, int n, bool max)
+{
+  float result = data[0];
+  for (int i = 1; i < n; i++)
+  {
+    if (max ? data[i] > result : data[i] < result)
+      result = data[i];
+  }
+  return result;
+}
+
+double _extreme_f64_scalar(const double *data, int n, bool max)
+{
+  double result = data[0];
+  for (int i = 1; i < n; i++)
+  {
+    if (max ? data[i] > result : data[i] < result)
+      result = data[i];
+  }
+  return result;
+}
+
+#if SIMD_X86
+
+/*
+SSE2 kernels (4 x 32 bit or 2 x 64 bit lanes).
+SSE2 is part of the x86-64 baseline, so these need no target attribute.
+Each kernel handles the tail that does not fill a vector with the
+scalar kernel. There is no SSE2 kernel for the int64_t min/max, as
+SSE2 has no 64 bit compare.
+*/
+static int _find_32_sse2(const uint32_t *data, int n, uint32_t key)
+{
+  __m128i keys = _mm_set1_epi32((int)key);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i)), keys);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  int found = _find_32_scalar(data + i, n - i, key);
+  return found < 0 ? -1 : i + found;
+}
+
+// 64 bit lanes are equal when both of their 32 bit halves are equal
+static inline __m128i _cmpeq_64_sse2(__m128i a, __m128i b)
+{
+  __m128i equal = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static int _find_64_sse2(const uint64_t *data, int n, uint64_t key)
+{
+  __m128i keys = _mm_set1_epi64x((long long)key);
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+  {
+    __m128i equal = _cmpeq_64_sse2(_mm_loadu_si128((const __m128i *)(data + i)), keys);
+    int mask = _mm_movemask_pd(_mm_castsi128_pd(equal));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  int found = _find_64_scalar(data + i, n - i, key);
+  return found < 0 ? -1 : i + found;
+}
+
+static int _count_32_sse2(const uint32_t *data, int n, uint32_t key)
+{
+  __m128i keys = _mm_set1_epi32((int)key);
+  __m128i counts = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    // Matching lanes are -1, so subtracting adds one per match
+    __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(data + i)), keys);
+    counts = _mm_sub_epi32(counts, equal);
+  }
+  int32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, counts);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + _count_32_scalar(data + i, n - i, key);
+}
+
+static int _count_64_sse2(const uint64_t *data, int n, uint64_t key)
+{
+  __m128i keys = _mm_set1_epi64x((long long)key);
+  __m128i counts = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+  {
+    __m128i equal = _cmpeq_64_sse2(_mm_loadu_si128((const __m128i *)(data + i)), keys);
+    counts = _mm_sub_epi64(counts, equal);
+  }
+  int64_t lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, counts);
+  return (int)(lanes[0] + lanes[1]) + _count_64_scalar(data + i, n - i, key);
+}
+
+static int64_t _sum_i32_sse2(const int32_t *data, int n)
+{
+  __m128i zero = _mm_setzero_si128();
+  __m128i sums = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    // Sign extend to 64 bit lanes by interleaving with the sign mask
+    __m128i values = _mm_loadu_si128((const __m128i *)(data + i));
+    __m128i sign = _mm_cmpgt_epi32(zero, values);
+    sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(values, sign));
+    sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(values, sign));
+  }
+  int64_t lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, sums);
+  return lanes[0] + lanes[1] + _sum_i32_scalar(data + i, n - i);
+}
+
+static int64_t _sum_i64_sse2(const int64_t *data, int n)
+{
+  __m128i sums = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    sums = _mm_add_epi64(sums, _mm_loadu_si128((const __m128i *)(data + i)));
+  uint64_t lanes[2];
+  _mm_storeu_si128((__m128i *)lanes, sums);
+  return (int64_t)(lanes[0] + lanes[1] + (uint64_t)_sum_i64_scalar(data + i, n - i));
+}
+
+static float _sum_f32_sse2(const float *data, int n)
+{
+  __m128 sums = _mm_setzero_ps();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    sums = _mm_add_ps(sums, _mm_loadu_ps(data + i));
+  float lanes[4];
+  _mm_storeu_ps(lanes, sums);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + _sum_f32_scalar(data + i, n - i);
+}
+
+static double _sum_f64_sse2(const double *data, int n)
+{
+  __m128d sums = _mm_setzero_pd();
+  int i = 0;
+  for (; i + 2 <= n; i += 2)
+    sums = _mm_add_pd(sums, _mm_loadu_pd(data + i));
+  double lanes[2];
+  _mm_storeu_pd(lanes, sums);
+  return lanes[0] + lanes[1] + _sum_f64_scalar(data + i, n - i);
+}
+
+static int32_t _extreme_i32_sse2(const int32_t *data, int n, bool max)
+{
+  if (n < 4)
+    return _extreme_i32_scalar(data, n, max);
+
+  __m128i result = _mm_loadu_si128((const __m128i *)data);
+  int i = 4;
+  for (; i + 4 <= n; i += 4)
+  {
+    // SSE2 has no pminsd/pmaxsd: select with a compare mask
+    __m128i values = _mm_loadu_si128((const __m128i *)(data + i));
+    __m128i take = max ? _mm_cmpgt_epi32(values, result) : _mm_cmpgt_epi32(result, values);
+    result = _mm_or_si128(_mm_and_si128(take, values), _mm_andnot_si128(take, result));
+  }
+  int32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, result);
+  int32_t extreme = _extreme_i32_scalar(lanes, 4, max);
+  if (i < n)
+  {
+    int32_t tail = _extreme_i32_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+static float _extreme_f32_sse2(const float *data, int n, bool max)
+{
+  if (n < 4)
+    return _extreme_f32_scalar(data, n, max);
+
+  __m128 result = _mm_loadu_ps(data);
+  int i = 4;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128 values = _mm_loadu_ps(data + i);
+    result = max ? _mm_max_ps(result, values) : _mm_min_ps(result, values);
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, result);
+  float extreme = _extreme_f32_scalar(lanes, 4, max);
+  if (i < n)
+  {
+    float tail = _extreme_f32_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+static double _extreme_f64_sse2(const double *data, int n, bool max)
+{
+  if (n < 2)
+    return _extreme_f64_scalar(data, n, max);
+
+  __m128d result = _mm_loadu_pd(data);
+  int i = 2;
+  for (; i + 2 <= n; i += 2)
+  {
+    __m128d values = _mm_loadu_pd(data + i);
+    result = max ? _mm_max_pd(result, values) : _mm_min_pd(result, values);
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, result);
+  double extreme = _extreme_f64_scalar(lanes, 2, max);
+  if (i < n)
+  {
+    double tail = _extreme_f64_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+/*
+AVX2 kernels (8 x 32 bit or 4 x 64 bit lanes).
+These are compiled for AVX2 with a target attribute, and are only
+called once _simd_level has checked that the CPU supports AVX2
+*/
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static int _find_32_avx2(const uint32_t *data, int n, uint32_t key)
+{
+  __m256i keys = _mm256_set1_epi32((int)key);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), keys);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  int found = _find_32_scalar(data + i, n - i, key);
+  return found < 0 ? -1 : i + found;
+}
+
+AVX2 static int _find_64_avx2(const uint64_t *data, int n, uint64_t key)
+{
+  __m256i keys = _mm256_set1_epi64x((long long)key);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i)), keys);
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  int found = _find_64_scalar(data + i, n - i, key);
+  return found < 0 ? -1 : i + found;
+}
+
+AVX2 static int _count_32_avx2(const uint32_t *data, int n, uint32_t key)
+{
+  __m256i keys = _mm256_set1_epi32((int)key);
+  __m256i counts = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), keys);
+    counts = _mm256_sub_epi32(counts, equal);
+  }
+  int32_t lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, counts);
+  int count = _count_32_scalar(data + i, n - i, key);
+  for (int lane = 0; lane < 8; lane++)
+    count += lanes[lane];
+  return count;
+}
+
+AVX2 static int _count_64_avx2(const uint64_t *data, int n, uint64_t key)
+{
+  __m256i keys = _mm256_set1_epi64x((long long)key);
+  __m256i counts = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(data + i)), keys);
+    counts = _mm256_sub_epi64(counts, equal);
+  }
+  int64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, counts);
+  return (int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + _count_64_scalar(data + i, n - i, key);
+}
+
+AVX2 static int64_t _sum_i32_avx2(const int32_t *data, int n)
+{
+  __m256i sums = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i values = _mm256_loadu_si256((const __m256i *)(data + i));
+    sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+    sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+  }
+  int64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, sums);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + _sum_i32_scalar(data + i, n - i);
+}
+
+AVX2 static int64_t _sum_i64_avx2(const int64_t *data, int n)
+{
+  __m256i sums = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    sums = _mm256_add_epi64(sums, _mm256_loadu_si256((const __m256i *)(data + i)));
+  uint64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, sums);
+  return (int64_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+                   (uint64_t)_sum_i64_scalar(data + i, n - i));
+}
+
+AVX2 static float _sum_f32_avx2(const float *data, int n)
+{
+  __m256 sums = _mm256_setzero_ps();
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    sums = _mm256_add_ps(sums, _mm256_loadu_ps(data + i));
+  float lanes[8];
+  _mm256_storeu_ps(lanes, sums);
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7])) +
+         _sum_f32_scalar(data + i, n - i);
+}
+
+AVX2 static double _sum_f64_avx2(const double *data, int n)
+{
+  __m256d sums = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    sums = _mm256_add_pd(sums, _mm256_loadu_pd(data + i));
+  double lanes[4];
+  _mm256_storeu_pd(lanes, sums);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + _sum_f64_scalar(data + i, n - i);
+}
+
+AVX2 static int32_t _extreme_i32_avx2(const int32_t *data, int n, bool max)
+{
+  if (n < 8)
+    return _extreme_i32_scalar(data, n, max);
+
+  __m256i result = _mm256_loadu_si256((const __m256i *)data);
+  int i = 8;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i values = _mm256_loadu_si256((const __m256i *)(data + i));
+    result = max ? _mm256_max_epi32(result, values) : _mm256_min_epi32(result, values);
+  }
+  int32_t lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, result);
+  int32_t extreme = _extreme_i32_scalar(lanes, 8, max);
+  if (i < n)
+  {
+    int32_t tail = _extreme_i32_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+AVX2 static int64_t _extreme_i64_avx2(const int64_t *data, int n, bool max)
+{
+  if (n < 4)
+    return _extreme_i64_scalar(data, n, max);
+
+  __m256i result = _mm256_loadu_si256((const __m256i *)data);
+  int i = 4;
+  for (; i + 4 <= n; i += 4)
+  {
+    // AVX2 has no 64 bit min/max: select with a compare mask
+    __m256i values = _mm256_loadu_si256((const __m256i *)(data + i));
+    __m256i take = max ? _mm256_cmpgt_epi64(values, result) : _mm256_cmpgt_epi64(result, values);
+    result = _mm256_blendv_epi8(result, values, take);
+  }
+  int64_t lanes[4];
+  _mm256_storeu_si256((__m256i *)lanes, result);
+  int64_t extreme = _extreme_i64_scalar(lanes, 4, max);
+  if (i < n)
+  {
+    int64_t tail = _extreme_i64_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+AVX2 static float _extreme_f32_avx2(const float *data, int n, bool max)
+{
+  if (n < 8)
+    return _extreme_f32_scalar(data, n, max);
+
+  __m256 result = _mm256_loadu_ps(data);
+  int i = 8;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256 values = _mm256_loadu_ps(data + i);
+    result = max ? _mm256_max_ps(result, values) : _mm256_min_ps(result, values);
+  }
+  float lanes[8];
+  _mm256_storeu_ps(lanes, result);
+  float extreme = _extreme_f32_scalar(lanes, 8, max);
+  if (i < n)
+  {
+    float tail = _extreme_f32_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+AVX2 static double _extreme_f64_avx2(const double *data, int n, bool max)
+{
+  if (n < 4)
+    return _extreme_f64_scalar(data, n, max);
+
+  __m256d result = _mm256_loadu_pd(data);
+  int i = 4;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m256d values = _mm256_loadu_pd(data + i);
+    result = max ? _mm256_max_pd(result, values) : _mm256_min_pd(result, values);
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, result);
+  double extreme = _extreme_f64_scalar(lanes, 4, max);
+  if (i < n)
+  {
+    double tail = _extreme_f64_scalar(data + i, n - i, max);
+    extreme = (max ? tail > extreme : tail < extreme) ? tail : extreme;
+  }
+  return extreme;
+}
+
+#endif
+
+/*
+Internal dispatch functions: call the kernel for the current _simd_level
+*/
+int _find_32(const uint32_t *data, int n, uint32_t key)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _find_32_avx2(data, n, key);
+  case SIMD_SSE2:
+    return _find_32_sse2(data, n, key);
+  default:
+    break;
+  }
+#endif
+  return _find_32_scalar(data, n, key);
+}
+
+int _find_64(const uint64_t *data, int n, uint64_t key)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _find_64_avx2(data, n, key);
+  case SIMD_SSE2:
+    return _find_64_sse2(data, n, key);
+  default:
+    break;
+  }
+#endif
+  return _find_64_scalar(data, n, key);
+}
+
+int _count_32(const uint32_t *data, int n, uint32_t key)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _count_32_avx2(data, n, key);
+  case SIMD_SSE2:
+    return _count_32_sse2(data, n, key);
+  default:
+    break;
+  }
+#endif
+  return _count_32_scalar(data, n, key);
+}
+
+int _count_64(const uint64_t *data, int n, uint64_t key)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _count_64_avx2(data, n, key);
+  case SIMD_SSE2:
+    return _count_64_sse2(data, n, key);
+  default:
+    break;
+  }
+#endif
+  return _count_64_scalar(data, n, key);
+}
+
+int64_t _sum_i32(const int32_t *data, int n)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _sum_i32_avx2(data, n);
+  case SIMD_SSE2:
+    return _sum_i32_sse2(data, n);
+  default:
+    break;
+  }
+#endif
+  return _sum_i32_scalar(data, n);
+}
+
+int64_t _sum_i64(const int64_t *data, int n)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _sum_i64_avx2(data, n);
+  case SIMD_SSE2:
+    return _sum_i64_sse2(data, n);
+  default:
+    break;
+  }
+#endif
+  return _sum_i64_scalar(data, n);
+}
+
+float _sum_f32(const float *data, int n)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _sum_f32_avx2(data, n);
+  case SIMD_SSE2:
+    return _sum_f32_sse2(data, n);
+  default:
+    break;
+  }
+#endif
+  return _sum_f32_scalar(data, n);
+}
+
+double _sum_f64(const double *data, int n)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _sum_f64_avx2(data, n);
+  case SIMD_SSE2:
+    return _sum_f64_sse2(data, n);
+  default:
+    break;
+  }
+#endif
+  return _sum_f64_scalar(data, n);
+}
+
+int32_t _extreme_i32(const int32_t *data, int n, bool max)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _extreme_i32_avx2(data, n, max);
+  case SIMD_SSE2:
+    return _extreme_i32_sse2(data, n, max);
+  default:
+    break;
+  }
+#endif
+  return _extreme_i32_scalar(data, n, max);
+}
+
+int64_t _extreme_i64(const int64_t *data, int n, bool max)
+{
+#if SIMD_X86
+  if (_simd_level() == SIMD_AVX2)
+    return _extreme_i64_avx2(data, n, max);
+#endif
+  return _extreme_i64_scalar(data, n, max);
+}
+
+float _extreme_f32(const float *data, int n, bool max)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _extreme_f32_avx2(data, n, max);
+  case SIMD_SSE2:
+    return _extreme_f32_sse2(data, n, max);
+  default:
+    break;
+  }
+#endif
+  return _extreme_f32_scalar(data, n, max);
+}
+
+double _extreme_f64(const double *data, int n, bool max)
+{
+#if SIMD_X86
+  switch (_simd_level())
+  {
+  case SIMD_AVX2:
+    return _extreme_f64_avx2(data, n, max);
+  case SIMD_SSE2:
+    return _extreme_f64_sse2(data, n, max);
+  default:
+    break;
+  }
+#endif
+  return _extreme_f64_scalar(data, n, max);
+}
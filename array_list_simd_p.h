@@ -0,0 +1,60 @@
+/**
+ * array_list_simd_p.h
+ *
+ * Private header file for the search, fill and reduction functions
+ * of the array_list module (array_list_simd.c)
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "array_list_p.h"
+
+#ifndef ARRAY_LIST_SIMD_P
+#define ARRAY_LIST_SIMD_P
+
+/**
+ * @brief The instruction set used by the search and reduction kernels
+ */
+typedef enum _simd_level
+{
+  SIMD_SCALAR = 0,
+  SIMD_SSE2,
+  SIMD_AVX2
+} _simd_level_t;
+
+_simd_level_t _simd_level(void);
+_simd_level_t _simd_max_level(void);
+void _simd_set_level(_simd_level_t level);
+
+// Dispatch to the kernel for the current level
+int _find_32(const uint32_t *data, int n, uint32_t key);
+int _find_64(const uint64_t *data, int n, uint64_t key);
+int _count_32(const uint32_t *data, int n, uint32_t key);
+int _count_64(const uint64_t *data, int n, uint64_t key);
+int64_t _sum_i32(const int32_t *data, int n);
+int64_t _sum_i64(const int64_t *data, int n);
+float _sum_f32(const float *data, int n);
+double _sum_f64(const double *data, int n);
+int32_t _extreme_i32(const int32_t *data, int n, bool max);
+int64_t _extreme_i64(const int64_t *data, int n, bool max);
+float _extreme_f32(const float *data, int n, bool max);
+double _extreme_f64(const double *data, int n, bool max);
+
+// Scalar kernels, used as the fallback and as the reference in tests
+int _find_32_scalar(const uint32_t *data, int n, uint32_t key);
+int _find_64_scalar(const uint64_t *data, int n, uint64_t key);
+int _count_32_scalar(const uint32_t *data, int n, uint32_t key);
+int _count_64_scalar(const uint64_t *data, int n, uint64_t key);
+int64_t _sum_i32_scalar(const int32_t *data, int n);
+int64_t _sum_i64_scalar(const int64_t *data, int n);
+float _sum_f32_scalar(const float *data, int n);
+double _sum_f64_scalar(const double *data, int n);
+int32_t _extreme_i32_scalar(const int32_t *data, int n, bool max);
+int64_t _extreme_i64_scalar(const int64_t *data, int n, bool max);
+float _extreme_f32_scalar(const float *data, int n, bool max);
+double _extreme_f64_scalar(const double *data, int n, bool max);
+
+#endif
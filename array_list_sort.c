@@ -0,0 +1,458 @@
+/**
+ * array_list_sort.c
+ *
+ * Implementation of the sort functions for the array_list module
+ *
+ * The sorts work directly on the contiguous list->data array, with one
+ * temporary buffer of the same size:
+ * - list_sort and list_stable_sort split a large list into one chunk per
+ *   thread, sort the chunks in parallel (qsort or a merge sort) and then
+ *   merge pairs of chunks in parallel until one run is left
+ * - list_radix_sort is an LSD radix sort on the bits of 32/64 bit keys
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "array_list_sort_p.h"
+
+// Lists smaller than this are sorted on the calling thread
+#define PARALLEL_SORT_THRESHOLD (1 << 17)
+
+// The minimum number of elements per thread for a parallel sort
+#define MIN_ELEMENTS_PER_THREAD (1 << 16)
+
+// Runs of at most this many elements are insertion sorted by _merge_sort
+#define INSERTION_SORT_THRESHOLD 16
+
+// Radix sort digit width
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+/*
+Sorts the list in place (the order of equal items is unspecified)
+
+Inputs:
+  list - pointer to an instance of the list type
+  cmp - the comparison function
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void list_sort(list_p list, list_compare_fn cmp)
+{
+  int threads = _sort_threads(list->size);
+  if (threads > 1)
+    _parallel_sort(list, cmp, false, threads);
+  else
+    qsort(list->data, list->size, list->element_size, cmp);
+}
+
+/*
+Sorts the list in place, keeping equal items in their original order
+
+Inputs:
+  list - pointer to an instance of the list type
+  cmp - the comparison function
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void list_stable_sort(list_p list, list_compare_fn cmp)
+{
+  if (list->size < 2)
+    return;
+
+  int threads = _sort_threads(list->size);
+  if (threads > 1)
+  {
+    _parallel_sort(list, cmp, true, threads);
+    return;
+  }
+
+  char *tmp = malloc((size_t)list->size * list->element_size);
+  assert(tmp != NULL && "Error in memory allocation");
+  _merge_sort(list->data, tmp, list->size, list->element_size, cmp);
+  free(tmp);
+}
+
+/*
+Sorts a list of 32/64 bit integers or floating point numbers into
+ascending order with a radix sort
+
+Inputs:
+  list - pointer to an instance of the list type
+  type - the type of the items
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the element size does not match type, or on memory allocation error
+
+*/
+void list_radix_sort(list_p list, list_key_type type)
+{
+  bool wide = (type == LIST_KEY_I64 || type == LIST_KEY_U64 || type == LIST_KEY_F64);
+  assert(list->element_size == (wide ? sizeof(uint64_t) : sizeof(uint32_t)) &&
+         "Error: Element size does not match the key type");
+  if (list->size < 2)
+    return;
+
+  void *tmp = malloc((size_t)list->size * list->element_size);
+  assert(tmp != NULL && "Error in memory allocation");
+  if (wide)
+    _radix_sort_64((uint64_t *)list->data, tmp, list->size, type);
+  else
+    _radix_sort_32((uint32_t *)list->data, tmp, list->size, type);
+  free(tmp);
+}
+
+/*
+Internal function to choose the number of threads for sorting n items
+
+Inputs:
+  n - the number of items
+
+Returns:
+  The number of threads (1 for a sequential sort)
+
+*/
+int _sort_threads(int n)
+{
+  if (n < PARALLEL_SORT_THRESHOLD)
+    return 1;
+
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  long threads = n / MIN_ELEMENTS_PER_THREAD;
+  if (cpus > 0 && threads > cpus)
+    threads = cpus;
+  return threads > 1 ? (int)threads : 1;
+}
+
+/*
+The work of one thread in a parallel sort: either sort one chunk,
+or merge the two adjacent sorted runs [start, start + left) and
+[start + left, start + count)
+*/
+struct _sort_job
+{
+  char *data;
+  char *tmp;
+  size_t start;
+  size_t left; // 0 to sort the chunk
+  size_t count;
+  size_t element_size;
+  list_compare_fn cmp;
+  bool stable;
+};
+
+static void *_sort_worker(void *arg)
+{
+  struct _sort_job *job = arg;
+  char *data = job->data + job->start * job->element_size;
+  char *tmp = job->tmp + job->start * job->element_size;
+
+  if (job->left == 0)
+  {
+    if (job->stable)
+      _merge_sort(data, tmp, job->count, job->element_size, job->cmp);
+    else
+      qsort(data, job->count, job->element_size, job->cmp);
+  }
+  else
+  {
+    _merge(data, tmp, job->left, job->count, job->element_size, job->cmp);
+  }
+  return NULL;
+}
+
+/*
+Internal function to sort a large list with several threads.
+The list is split into one chunk per thread and the chunks are sorted
+in parallel. Adjacent runs are then merged in pairs (in parallel) until
+a single run is left. Merging is stable, so the result is stable when
+the chunks are sorted stably
+
+Inputs:
+  list - pointer to an instance of the list type
+  cmp - the comparison function
+  stable - whether equal items must keep their order
+  threads - the number of threads (at most the list size)
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void _parallel_sort(list_p list, list_compare_fn cmp, bool stable, int threads)
+{
+  size_t n = list->size;
+  size_t es = list->element_size;
+
+  char *tmp = malloc(n * es);
+  assert(tmp != NULL && "Error in memory allocation");
+
+  // Run boundaries: run i is [bounds[i], bounds[i + 1])
+  size_t bounds[threads + 1];
+  for (int i = 0; i <= threads; i++)
+    bounds[i] = n * i / threads;
+
+  pthread_t ids[threads];
+  struct _sort_job jobs[threads];
+  for (int i = 0; i < threads; i++)
+  {
+    jobs[i] = (struct _sort_job){list->data, tmp, bounds[i], 0, bounds[i + 1] - bounds[i], es, cmp, stable};
+    pthread_create(&ids[i], NULL, _sort_worker, &jobs[i]);
+  }
+  for (int i = 0; i < threads; i++)
+    pthread_join(ids[i], NULL);
+
+  // Merge pairs of runs; an odd run at the end is carried to the next round
+  int runs = threads;
+  while (runs > 1)
+  {
+    int pairs = runs / 2;
+    for (int i = 0; i < pairs; i++)
+    {
+      size_t start = bounds[2 * i];
+      jobs[i] = (struct _sort_job){list->data, tmp, start, bounds[2 * i + 1] - start,
+                                   bounds[2 * i + 2] - start, es, cmp, stable};
+      pthread_create(&ids[i], NULL, _sort_worker, &jobs[i]);
+    }
+    for (int i = 0; i < pairs; i++)
+      pthread_join(ids[i], NULL);
+
+    for (int i = 0; i < pairs; i++)
+      bounds[i] = bounds[2 * i];
+    if (runs % 2)
+      bounds[pairs] = bounds[runs - 1];
+    runs = (runs + 1) / 2;
+    bounds[runs] = n;
+  }
+
+  free(tmp);
+}
+
+/*
+Internal function to merge sort n items (stable).
+Short runs are insertion sorted, and two sorted halves which are
+already in order are not merged
+
+Inputs:
+  data - the items to sort
+  tmp - a buffer of at least n items
+  n - the number of items
+  element_size - the size of each item
+  cmp - the comparison function
+
+Returns:
+  Nothing
+
+*/
+void _merge_sort(char *data, char *tmp, size_t n, size_t element_size, list_compare_fn cmp)
+{
+  if (n <= INSERTION_SORT_THRESHOLD)
+  {
+    // tmp holds the item being inserted
+    for (size_t i = 1; i < n; i++)
+    {
+      char *item = data + i * element_size;
+      size_t j = i;
+      while (j > 0 && cmp(data + (j - 1) * element_size, item) > 0)
+        j--;
+      if (j < i)
+      {
+        memcpy(tmp, item, element_size);
+        memmove(data + (j + 1) * element_size, data + j * element_size, (i - j) * element_size);
+        memcpy(data + j * element_size, tmp, element_size);
+      }
+    }
+    return;
+  }
+
+  size_t left = n / 2;
+  _merge_sort(data, tmp, left, element_size, cmp);
+  _merge_sort(data + left * element_size, tmp + left * element_size, n - left, element_size, cmp);
+  _merge(data, tmp, left, n, element_size, cmp);
+}
+
+/*
+Internal function to merge the sorted runs [0, left) and [left, n) of
+data into one sorted run (stable). The left run is copied to tmp and
+merged back with the right run; the write position never passes the
+read position in the right run, so the right run can stay in place
+
+Inputs:
+  data - the items (two sorted runs)
+  tmp - a buffer of at least left items
+  left - the number of items in the first run
+  n - the total number of items
+  element_size - the size of each item
+  cmp - the comparison function
+
+Returns:
+  Nothing
+
+*/
+void _merge(char *data, char *tmp, size_t left, size_t n, size_t element_size, list_compare_fn cmp)
+{
+  if (left == 0 || left == n)
+    return;
+
+  // Already in order
+  if (cmp(data + (left - 1) * element_size, data + left * element_size) <= 0)
+    return;
+
+  memcpy(tmp, data, left * element_size);
+  char *a = tmp;
+  char *a_end = tmp + left * element_size;
+  char *b = data + left * element_size;
+  char *b_end = data + n * element_size;
+  char *out = data;
+
+  while (a < a_end && b < b_end)
+  {
+    // Take from the left run on ties, for stability
+    if (cmp(a, b) <= 0)
+    {
+      memcpy(out, a, element_size);
+      a += element_size;
+    }
+    else
+    {
+      memcpy(out, b, element_size);
+      b += element_size;
+    }
+    out += element_size;
+  }
+  // Whatever is left of the right run is already in place
+  memcpy(out, a, a_end - a);
+}
+
+/*
+Internal functions to map a value to an unsigned key with the same order
+*/
+static inline uint32_t _radix_key_32(uint32_t bits, list_key_type type)
+{
+  if (type == LIST_KEY_I32)
+    return bits ^ 0x80000000u;
+  if (type == LIST_KEY_F32)
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  return bits;
+}
+
+static inline uint64_t _radix_key_64(uint64_t bits, list_key_type type)
+{
+  if (type == LIST_KEY_I64)
+    return bits ^ 0x8000000000000000u;
+  if (type == LIST_KEY_F64)
+    return (bits & 0x8000000000000000u) ? ~bits : bits | 0x8000000000000000u;
+  return bits;
+}
+
+/*
+Internal functions for the LSD radix sort of 32/64 bit items.
+The histograms of every digit are counted in one pass; passes in which
+every item has the same digit are skipped. The items move between data
+and tmp on each pass, and are copied back if they end in tmp
+
+Inputs:
+  data - the items to sort
+  tmp - a buffer of n items
+  n - the number of items
+  type - the type of the items
+
+Returns:
+  Nothing
+
+*/
+void _radix_sort_32(uint32_t *data, uint32_t *tmp, size_t n, list_key_type type)
+{
+  enum { DIGITS = 32 / RADIX_BITS };
+  size_t counts[DIGITS][RADIX_BUCKETS] = {{0}};
+  for (size_t i = 0; i < n; i++)
+  {
+    uint32_t key = _radix_key_32(data[i], type);
+    for (int d = 0; d < DIGITS; d++)
+      counts[d][(key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+  }
+
+  uint32_t *src = data;
+  uint32_t *dst = tmp;
+  for (int d = 0; d < DIGITS; d++)
+  {
+    int shift = d * RADIX_BITS;
+    if (counts[d][(_radix_key_32(src[0], type) >> shift) & (RADIX_BUCKETS - 1)] == n)
+      continue;
+
+    size_t offsets[RADIX_BUCKETS];
+    size_t total = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++)
+    {
+      offsets[b] = total;
+      total += counts[d][b];
+    }
+    for (size_t i = 0; i < n; i++)
+      dst[offsets[(_radix_key_32(src[i], type) >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+
+    uint32_t *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data)
+    memcpy(data, src, n * sizeof(uint32_t));
+}
+
+void _radix_sort_64(uint64_t *data, uint64_t *tmp, size_t n, list_key_type type)
+{
+  enum { DIGITS = 64 / RADIX_BITS };
+  size_t counts[DIGITS][RADIX_BUCKETS] = {{0}};
+  for (size_t i = 0; i < n; i++)
+  {
+    uint64_t key = _radix_key_64(data[i], type);
+    for (int d = 0; d < DIGITS; d++)
+      counts[d][(key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+  }
+
+  uint64_t *src = data;
+  uint64_t *dst = tmp;
+  for (int d = 0; d < DIGITS; d++)
+  {
+    int shift = d * RADIX_BITS;
+    if (counts[d][(_radix_key_64(src[0], type) >> shift) & (RADIX_BUCKETS - 1)] == n)
+      continue;
+
+    size_t offsets[RADIX_BUCKETS];
+    size_t total = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++)
+    {
+      offsets[b] = total;
+      total += counts[d][b];
+    }
+    for (size_t i = 0; i < n; i++)
+      dst[offsets[(_radix_key_64(src[i], type) >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+
+    uint64_t *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data)
+    memcpy(data, src, n * sizeof(uint64_t));
+}
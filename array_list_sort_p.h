@@ -0,0 +1,25 @@
+/**
+ * array_list_sort_p.h
+ *
+ * Private header file for the sort functions
+ * of the array_list module (array_list_sort.c)
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "array_list_p.h"
+
+#ifndef ARRAY_LIST_SORT_P
+#define ARRAY_LIST_SORT_P
+
+int _sort_threads(int n);
+void _parallel_sort(list_p list, list_compare_fn cmp, bool stable, int threads);
+void _merge_sort(char *data, char *tmp, size_t n, size_t element_size, list_compare_fn cmp);
+void _merge(char *data, char *tmp, size_t left, size_t n, size_t element_size, list_compare_fn cmp);
+void _radix_sort_32(uint32_t *data, uint32_t *tmp, size_t n, list_key_type type);
+void _radix_sort_64(uint64_t *data, uint64_t *tmp, size_t n, list_key_type type);
+
+#endif
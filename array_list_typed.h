@@ -0,0 +1,138 @@
+/**
+ * @file array_list_typed.h
+ * @brief Header-only, type-specialised array lists generated by macro
+ *
+ * DEFINE_ARRAY_LIST(T) generates a list type and functions for elements
+ * of type T. Because the element type is known at compile time, element
+ * moves are plain assignments (or memmoves of a constant element size)
+ * that the compiler can inline and vectorise, rather than memcpys of
+ * list->element_size bytes as in the generic array_list module.
+ *
+ * T must be a single identifier (e.g. int, double, or a typedef name).
+ * Example usage to create a list of doubles:
+ * DEFINE_ARRAY_LIST(double)
+ * ...
+ * list_double_p my_list = list_double_create();
+ * list_double_append(my_list, 1.5);
+ * double value = list_double_get(my_list, 0);
+ *
+ * The generated functions for a type T are:
+ *   list_T_p list_T_create(void)
+ *   void list_T_append(list_T_p list, T value)
+ *   void list_T_insert(list_T_p list, T value, int index)
+ *   T list_T_get(list_T_p list, int index)
+ *   void list_T_set(list_T_p list, T value, int index)
+ *   void list_T_remove(list_T_p list, int index)
+ *   int list_T_size(list_T_p list)
+ *   T *list_T_data(list_T_p list)
+ *   void list_T_delete(list_T_p list)
+ * They behave as the functions of the same name in array_list.h, with
+ * values passed and returned by value. The pointer from list_T_data is
+ * invalidated by the same operations as list_data_span.
+ * Growth and shrinking follow the array_list defaults.
+ *
+ * DEFINE_ARRAY_LIST(T) may be used once per type in each source file.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef ARRAY_LIST_TYPED
+#define ARRAY_LIST_TYPED
+
+// The initial capacity, and the grow/shrink factors (as for array_list.c)
+#define TYPED_LIST_INITIAL_CAPACITY 16
+#define TYPED_LIST_GROW_FACTOR 2
+#define TYPED_LIST_SHRINK_DIVISOR 2
+
+#define DEFINE_ARRAY_LIST(T)                                                          \
+                                                                                      \
+  typedef struct list_##T                                                             \
+  {                                                                                   \
+    T *data;                                                                          \
+    int size;                                                                         \
+    int capacity;                                                                     \
+  } *list_##T##_p;                                                                    \
+                                                                                      \
+  static inline void _list_##T##_resize(list_##T##_p list, int capacity)              \
+  {                                                                                   \
+    list->data = (T *)realloc(list->data, (size_t)capacity * sizeof(T));              \
+    assert(list->data != NULL && "Error: Cannot resize list (Memory allocation failed).\n"); \
+    list->capacity = capacity;                                                        \
+  }                                                                                   \
+                                                                                      \
+  static inline list_##T##_p list_##T##_create(void)                                  \
+  {                                                                                   \
+    list_##T##_p list = (list_##T##_p)malloc(sizeof(struct list_##T));                \
+    assert(list != NULL && "Error in memory allocation");                             \
+    list->size = 0;                                                                   \
+    list->capacity = TYPED_LIST_INITIAL_CAPACITY;                                     \
+    list->data = (T *)malloc(list->capacity * sizeof(T));                             \
+    assert(list->data != NULL && "Error in memory allocation");                       \
+    return list;                                                                      \
+  }                                                                                   \
+                                                                                      \
+  static inline void list_##T##_insert(list_##T##_p list, T value, int index)         \
+  {                                                                                   \
+    assert(index >= 0 && index <= list->size && "Error: Cannot add element at index"); \
+    if (list->size >= list->capacity)                                                 \
+      _list_##T##_resize(list, list->capacity * TYPED_LIST_GROW_FACTOR);              \
+    memmove(list->data + index + 1, list->data + index,                               \
+            (size_t)(list->size - index) * sizeof(T));                                \
+    list->data[index] = value;                                                        \
+    list->size++;                                                                     \
+  }                                                                                   \
+                                                                                      \
+  static inline void list_##T##_append(list_##T##_p list, T value)                    \
+  {                                                                                   \
+    if (list->size >= list->capacity)                                                 \
+      _list_##T##_resize(list, list->capacity * TYPED_LIST_GROW_FACTOR);              \
+    list->data[list->size++] = value;                                                 \
+  }                                                                                   \
+                                                                                      \
+  static inline T list_##T##_get(list_##T##_p list, int index)                        \
+  {                                                                                   \
+    assert(index >= 0 && index < list->size && "Error: list index out of range");     \
+    return list->data[index];                                                         \
+  }                                                                                   \
+                                                                                      \
+  static inline void list_##T##_set(list_##T##_p list, T value, int index)            \
+  {                                                                                   \
+    assert(index >= 0 && index < list->size && "Error: list index out of range");     \
+    list->data[index] = value;                                                        \
+  }                                                                                   \
+                                                                                      \
+  static inline void list_##T##_remove(list_##T##_p list, int index)                  \
+  {                                                                                   \
+    assert(index >= 0 && index < list->size && "Error: Cannot remove element at index"); \
+    if (list->size <= list->capacity / 4 && list->size > TYPED_LIST_INITIAL_CAPACITY) \
+      _list_##T##_resize(list, list->capacity / TYPED_LIST_SHRINK_DIVISOR);          \
+    memmove(list->data + index, list->data + index + 1,                               \
+            (size_t)(list->size - index - 1) * sizeof(T));                            \
+    list->size--;                                                                     \
+  }                                                                                   \
+                                                                                      \
+  static inline int list_##T##_size(list_##T##_p list)                                \
+  {                                                                                   \
+    return list->size;                                                                \
+  }                                                                                   \
+                                                                                      \
+  static inline T *list_##T##_data(list_##T##_p list)                                 \
+  {                                                                                   \
+    return list->data;                                                                \
+  }                                                                                   \
+                                                                                      \
+  static inline void list_##T##_delete(list_##T##_p list)                             \
+  {                                                                                   \
+    if (list)                                                                         \
+    {                                                                                 \
+      if (list->data)                                                                 \
+        free(list->data);                                                             \
+      free(list);                                                                     \
+    }                                                                                 \
+  }
+
+#endif
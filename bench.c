@@ -0,0 +1,407 @@
+/**
+ * Benchmark driver for data structures modules
+ *
+ * Usage: ./datastructs_bench [options] [suite ...]
+ * Runs all suites if no suite names are given, and fails on unknown suite names.
+ *
+ * Options:
+ *   --format=text|csv|json  output format (default text)
+ *   --warmup=N              untimed runs before each benchmark run by bench_run (default 1)
+ *   --repeat=N              timed runs of each benchmark run by bench_run (default 5)
+ *   --seed=N                seed for bench_rand and rand, reset for each suite (default 1)
+ *   --max-size=N            largest structure size (in items) and most operations
+ *                           per benchmark in every suite (by default, each suite
+ *                           uses its own sizes, and the ops suite stops at 10000000)
+ *   --filter=TEXT           only run/report benchmarks whose names contain TEXT
+ *
+ * Benchmarks run through bench_run report the minimum, median (p50), p90,
+ * p99, maximum and mean time per operation over the timed runs; those
+ * timed once by the suite itself (bench_report) report that single run.
+ * The csv and json formats have one record per benchmark with the same
+ * fields, so results can be compared between commits.
+ *
+ * Only these records are printed to stdout. Other output, such as memory
+ * use and errors, is printed to stderr. When built with INSTRUMENT=1, the
+ * hardware counter totals of the list and queue operations (perf_counters.h)
+ * are also printed to stderr after each suite.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "perf_counters.h"
+
+volatile long bench_sink;
+
+// The most timed runs kept for a benchmark
+#define MAX_REPEATS 1000
+
+// The largest structure size of the ops suite when --max-size is not given
+#define DEFAULT_MAX_SIZE 10000000
+
+typedef enum bench_format
+{
+  FORMAT_TEXT = 0,
+  FORMAT_CSV,
+  FORMAT_JSON
+} bench_format;
+
+/*
+The options of the driver (see Usage above)
+*/
+static struct
+{
+  bench_format format;
+  int warmup;
+  int repeats;
+  uint64_t seed;
+  long max_size; // 0 if not given
+  const char *filter;
+} options = {FORMAT_TEXT, 1, 5, 1, 0, NULL};
+
+// The state of bench_rand, and the number of records written (for json commas)
+static uint64_t rand_state;
+static int records;
+
+/*
+The benchmark suites known to the driver
+*/
+static const struct
+{
+  const char *name;
+  void (*run)(void);
+} suites[] = {
+    {"ops", bench_ops},
+    {"allocator", bench_allocator},
+    {"pages", bench_allocator_pages},
+    {"array_list", bench_array_list},
+    {"typed_list", bench_array_list_typed},
+    {"list_simd", bench_array_list_simd},
+    {"list_sort", bench_array_list_sort},
+    {"list_search", bench_array_list_search},
+    {"list_mapped", bench_array_list_mapped},
+    {"queue", bench_queue},
+    {"deque", bench_deque},
+    {"spsc_queue", bench_spsc_queue},
+    {"mpmc_queue", bench_mpmc_queue},
+    {"blocking_queue", bench_blocking_queue},
+    {"scheduler", bench_scheduler},
+    {"serialize", bench_serialize},
+};
+
+#define NUM_SUITES (int)(sizeof(suites) / sizeof(suites[0]))
+
+static void emit(const char *suite, const char *name, long ops, double *seconds, int runs);
+static bool parse_options(int argc, char *argv[]);
+
+int main(int argc, char *argv[])
+{
+  if (!parse_options(argc, argv))
+  {
+    fprintf(stderr, "Usage: %s [--format=text|csv|json] [--warmup=N] [--repeat=N] "
+                    "[--seed=N] [--max-size=N] [--filter=TEXT] [suite ...]\n",
+            argv[0]);
+    return 1;
+  }
+
+  // Suite names are the arguments which are not options
+  bool any_suite = false;
+  for (int arg = 1; arg < argc; arg++)
+  {
+    if (strncmp(argv[arg], "--", 2) == 0)
+      continue;
+    any_suite = true;
+    bool known = false;
+    for (int i = 0; i < NUM_SUITES; i++)
+    {
+      if (strcmp(argv[arg], suites[i].name) == 0)
+        known = true;
+    }
+    if (!known)
+    {
+      fprintf(stderr, "Error: unknown suite '%s'. The suites are:", argv[arg]);
+      for (int i = 0; i < NUM_SUITES; i++)
+        fprintf(stderr, " %s", suites[i].name);
+      fprintf(stderr, "\n");
+      return 1;
+    }
+  }
+
+  if (options.format == FORMAT_CSV)
+    printf("suite,name,ops,runs,min_ns_per_op,p50_ns_per_op,p90_ns_per_op,p99_ns_per_op,"
+           "max_ns_per_op,mean_ns_per_op,mops_per_s\n");
+  else if (options.format == FORMAT_JSON)
+    printf("[");
+
+  for (int i = 0; i < NUM_SUITES; i++)
+  {
+    bool selected = !any_suite;
+    for (int arg = 1; arg < argc; arg++)
+    {
+      if (strcmp(argv[arg], suites[i].name) == 0)
+        selected = true;
+    }
+    if (selected)
+    {
+      // Each suite gets the same random numbers, whichever suites are run
+      rand_state = options.seed;
+      srand((unsigned)options.seed);
+      perf_counters_reset();
+      suites[i].run();
+      if (perf_counters_enabled())
+      {
+        fprintf(stderr, "--- %s: perf counters ---\n", suites[i].name);
+        perf_counters_dump(stderr);
+      }
+    }
+  }
+
+  if (options.format == FORMAT_JSON)
+    printf("\n]\n");
+  return 0;
+}
+
+/*
+Parse the options (arguments starting with --) into options
+
+Inputs:
+  argc, argv - the arguments of main
+
+Returns:
+  true if all of the options are valid
+
+*/
+static bool parse_options(int argc, char *argv[])
+{
+  for (int arg = 1; arg < argc; arg++)
+  {
+    const char *option = argv[arg];
+    const char *value = strchr(option, '=');
+    if (strncmp(option, "--", 2) != 0)
+      continue;
+    if (value == NULL)
+      return false;
+    value++;
+
+    if (strncmp(option, "--format=", 9) == 0)
+    {
+      if (strcmp(value, "text") == 0)
+        options.format = FORMAT_TEXT;
+      else if (strcmp(value, "csv") == 0)
+        options.format = FORMAT_CSV;
+      else if (strcmp(value, "json") == 0)
+        options.format = FORMAT_JSON;
+      else
+        return false;
+    }
+    else if (strncmp(option, "--warmup=", 9) == 0)
+      options.warmup = atoi(value);
+    else if (strncmp(option, "--repeat=", 9) == 0)
+      options.repeats = atoi(value);
+    else if (strncmp(option, "--seed=", 7) == 0)
+      options.seed = strtoull(value, NULL, 10);
+    else if (strncmp(option, "--max-size=", 11) == 0)
+    {
+      options.max_size = atol(value);
+      if (options.max_size <= 0)
+        return false;
+    }
+    else if (strncmp(option, "--filter=", 9) == 0)
+      options.filter = value;
+    else
+      return false;
+  }
+  return options.warmup >= 0 && options.repeats >= 1 && options.repeats <= MAX_REPEATS;
+}
+
+/*
+Get the current time from a monotonic clock
+
+Returns:
+  The time in seconds
+
+*/
+double bench_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+Print the result of a timed benchmark run
+
+Inputs:
+  suite - the name of the benchmark suite
+  name - the name of the benchmark within the suite
+  ops - the number of operations performed
+  seconds - the elapsed time for all operations
+
+Returns:
+  Nothing
+
+*/
+void bench_report(const char *suite, const char *name, long ops, double seconds)
+{
+  if (bench_selected(name))
+    emit(suite, name, ops, &seconds, 1);
+}
+
+/*
+Run a benchmark options.warmup times untimed, then options.repeats times,
+and print the spread of the times per operation
+
+Inputs:
+  suite - the name of the benchmark suite
+  name - the name of the benchmark within the suite
+  ops - the number of operations in each run
+  run - function which performs one run and returns its elapsed time
+        (so it can leave setup and cleanup out of the timing)
+  ctx - pointer passed through to run
+
+Returns:
+  Nothing
+
+*/
+void bench_run(const char *suite, const char *name, long ops, double (*run)(void *ctx), void *ctx)
+{
+  if (!bench_selected(name))
+    return;
+
+  double seconds[MAX_REPEATS];
+  for (int i = 0; i < options.warmup; i++)
+    run(ctx);
+  for (int i = 0; i < options.repeats; i++)
+    seconds[i] = run(ctx);
+  emit(suite, name, ops, seconds, options.repeats);
+}
+
+/*
+Check whether a benchmark is selected by the --filter option,
+so that a suite can skip the setup for benchmarks which will not be run
+
+Inputs:
+  name - the name of the benchmark within the suite
+
+Returns:
+  true if the benchmark should be run
+
+*/
+bool bench_selected(const char *name)
+{
+  return options.filter == NULL || strstr(name, options.filter) != NULL;
+}
+
+/*
+Get the largest structure size (in items) for the ops suite
+
+Returns:
+  --max-size, or DEFAULT_MAX_SIZE if it is not given
+
+*/
+long bench_max_size(void)
+{
+  return options.max_size > 0 ? options.max_size : DEFAULT_MAX_SIZE;
+}
+
+/*
+Limit a structure size or number of operations chosen by a suite
+to --max-size (if given)
+
+Inputs:
+  size - the size (in items) or number of operations the suite would use
+
+Returns:
+  size, or --max-size if that is smaller
+
+*/
+long bench_size(long size)
+{
+  if (options.max_size > 0 && size > options.max_size)
+    return options.max_size;
+  return size;
+}
+
+/*
+Get the next number from the seeded random generator (splitmix64).
+The generator is reset to the --seed value at the start of each suite,
+so a suite generates the same workload on every run
+
+Returns:
+  A random 64 bit number
+
+*/
+uint64_t bench_rand(void)
+{
+  uint64_t z = (rand_state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static int compare_double(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/*
+Print one benchmark record in the selected format.
+Percentiles are by the nearest rank over the runs
+
+Inputs:
+  suite - the name of the benchmark suite
+  name - the name of the benchmark within the suite
+  ops - the number of operations in each run
+  seconds - the elapsed time of each run (sorted in place)
+  runs - the number of runs
+
+Returns:
+  Nothing
+
+*/
+static void emit(const char *suite, const char *name, long ops, double *seconds, int runs)
+{
+  qsort(seconds, runs, sizeof(double), compare_double);
+  double mean = 0;
+  for (int i = 0; i < runs; i++)
+    mean += seconds[i] / runs;
+
+  double scale = 1e9 / ops; // seconds per run to ns per op
+  double min = seconds[0] * scale;
+  double p50 = seconds[(runs * 50 + 99) / 100 - 1] * scale;
+  double p90 = seconds[(runs * 90 + 99) / 100 - 1] * scale;
+  double p99 = seconds[(runs * 99 + 99) / 100 - 1] * scale;
+  double max = seconds[runs - 1] * scale;
+  double mops = 1e3 / p50;
+
+  switch (options.format)
+  {
+  case FORMAT_TEXT:
+    if (runs == 1)
+      printf("%-14s %-40s %12ld ops %10.2f ns/op %10.2f Mops/s\n", suite, name, ops, p50, mops);
+    else
+      printf("%-14s %-40s %12ld ops %10.2f ns/op %10.2f Mops/s  (min %.2f p90 %.2f p99 %.2f max %.2f, %d runs)\n",
+             suite, name, ops, p50, mops, min, p90, p99, max, runs);
+    break;
+  case FORMAT_CSV:
+    printf("%s,\"%s\",%ld,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+           suite, name, ops, runs, min, p50, p90, p99, max, mean * scale, mops);
+    break;
+  case FORMAT_JSON:
+    printf("%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"ops\": %ld, \"runs\": %d, "
+           "\"min_ns_per_op\": %.3f, \"p50_ns_per_op\": %.3f, \"p90_ns_per_op\": %.3f, "
+           "\"p99_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, \"mean_ns_per_op\": %.3f, "
+           "\"mops_per_s\": %.3f}",
+           records > 0 ? "," : "", suite, name, ops, runs, min, p50, p90, p99, max, mean * scale, mops);
+    break;
+  }
+  records++;
+  fflush(stdout);
+}
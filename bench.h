@@ -0,0 +1,104 @@
+/**
+ * @file bench.h
+ * @brief Shared helpers and suite prototypes for the benchmark driver
+ *
+ * @author ruairin
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef BENCH
+#define BENCH
+
+/**
+ * @brief Sink for benchmark results so the compiler cannot discard the work
+ */
+extern volatile long bench_sink;
+
+/**
+ * @brief Get the current time from a monotonic clock
+ * @return The time in seconds
+ */
+double bench_now(void);
+
+/**
+ * @brief Print the result of a benchmark timed once by the suite
+ *
+ * @param[in] suite The name of the benchmark suite
+ * @param[in] name The name of the benchmark within the suite
+ * @param[in] ops The number of operations performed
+ * @param[in] seconds The elapsed time for all operations
+ * @return nothing
+ */
+void bench_report(const char *suite, const char *name, long ops, double seconds);
+
+/**
+ * @brief Run a benchmark with warmup and repeated timed runs, and print
+ *        the spread of the time per operation (min, p50, p90, p99, max, mean)
+ *
+ * @param[in] suite The name of the benchmark suite
+ * @param[in] name The name of the benchmark within the suite
+ * @param[in] ops The number of operations in each run
+ * @param[in] run Function which performs one run and returns the elapsed
+ *                time of its timed part (from bench_now)
+ * @param[in] ctx Pointer passed through to run
+ * @return nothing
+ */
+void bench_run(const char *suite, const char *name, long ops, double (*run)(void *ctx), void *ctx);
+
+/**
+ * @brief Check whether a benchmark is selected by the --filter option
+ *
+ * @param[in] name The name of the benchmark within the suite
+ * @return true if the benchmark should be run
+ */
+bool bench_selected(const char *name);
+
+/**
+ * @brief Get the largest structure size (in items) for the ops suite
+ * @return --max-size, or 10000000 if it is not given
+ */
+long bench_max_size(void);
+
+/**
+ * @brief Limit a structure size or number of operations to --max-size
+ *
+ * Suites pass each of their sizes and operation counts through this,
+ * so that --max-size bounds every suite.
+ *
+ * @param[in] size The size (in items) or number of operations the suite would use
+ * @return size, or --max-size if it is given and smaller
+ */
+long bench_size(long size);
+
+/**
+ * @brief Get the next number from the seeded random generator
+ *
+ * The generator (and rand) is reset to the --seed value at the start
+ * of each suite, so workloads are the same from run to run.
+ *
+ * @return A random 64 bit number
+ */
+uint64_t bench_rand(void);
+
+// Benchmark suites (one per bench_<suite>.c file)
+void bench_ops(void);
+void bench_allocator(void);
+void bench_allocator_pages(void);
+void bench_array_list(void);
+void bench_array_list_typed(void);
+void bench_array_list_simd(void);
+void bench_array_list_sort(void);
+void bench_array_list_search(void);
+void bench_array_list_mapped(void);
+void bench_queue(void);
+void bench_deque(void);
+void bench_spsc_queue(void);
+void bench_mpmc_queue(void);
+void bench_blocking_queue(void);
+void bench_scheduler(void);
+void bench_serialize(void);
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * Benchmarks for the allocator module, used by the list and linked queue
+ *
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "allocator.h"
+#include "array_list.h"
+#include "queue.h"
+
+// Number of operations for the queue benchmarks (at most --max-size)
+#define NUM_OPS (1 << 20)
+static int num_ops;
+
+// Number of items kept in the queue for the steady state benchmarks
+#define STEADY_LENGTH 64
+
+// Number of simulated requests (at most --max-size), and the work done in each
+#define NUM_REQUESTS 20000
+static int num_requests;
+#define STRUCTS_PER_REQUEST 4
+#define ITEMS_PER_STRUCT 64
+
+static void bench_queue_steady(const char *name, const allocator *alloc)
+{
+  queue_p queue = queue_create_ex(sizeof(int), alloc);
+  int value = 0;
+  long sum = 0;
+
+  for (int i = 0; i < STEADY_LENGTH; i++)
+    queue_enqueue(queue, &i);
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    queue_enqueue(queue, &i);
+    queue_dequeue(queue, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("allocator", name, 2L * num_ops, elapsed);
+  queue_delete(queue);
+}
+
+static void bench_queue_pool_vs_heap(void)
+{
+  allocator heap = allocator_default();
+  bench_queue_steady("queue enqueue+dequeue (heap)", &heap);
+
+  pool_p pool = pool_create(queue_node_size(sizeof(int)), 1024);
+  allocator pooled = pool_allocator(pool);
+  bench_queue_steady("queue enqueue+dequeue (pool)", &pooled);
+  pool_delete(pool);
+}
+
+/*
+Builds and deletes a few short-lived lists and queues per request.
+With the arena, nothing is deleted individually: the arena is reset
+once per request
+*/
+static void bench_requests(const char *name, arena_p arena)
+{
+  allocator alloc = arena ? arena_allocator(arena) : allocator_default();
+  int value = 0;
+  long sum = 0;
+
+  double start = bench_now();
+  for (int r = 0; r < num_requests; r++)
+  {
+    for (int s = 0; s < STRUCTS_PER_REQUEST; s++)
+    {
+      list_p list = list_create_ex(sizeof(int), &alloc);
+      queue_p queue = queue_create_ex(sizeof(int), &alloc);
+      for (int i = 0; i < ITEMS_PER_STRUCT; i++)
+      {
+        list_append(list, &i);
+        queue_enqueue(queue, &i);
+      }
+      for (int i = 0; i < ITEMS_PER_STRUCT; i++)
+      {
+        queue_dequeue(queue, &value);
+        sum += value;
+      }
+      if (arena == NULL)
+      {
+        list_delete(list);
+        queue_delete(queue);
+      }
+    }
+    if (arena)
+      arena_reset(arena);
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("allocator", name, num_requests, elapsed);
+}
+
+static void bench_requests_arena_vs_heap(void)
+{
+  bench_requests("short-lived lists+queues per request (heap)", NULL);
+
+  arena_p arena = arena_create(0);
+  bench_requests("short-lived lists+queues per request (arena)", arena);
+  arena_delete(arena);
+}
+
+void bench_allocator(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  num_requests = (int)bench_size(NUM_REQUESTS);
+  bench_queue_pool_vs_heap();
+  bench_requests_arena_vs_heap();
+}
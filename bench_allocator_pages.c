@@ -0,0 +1,78 @@
+/**
+ * Random access benchmarks for large lists with data arrays from the
+ * heap and from the page allocator (huge pages, NUMA placement).
+ * With a 512MB array, most random accesses miss the TLB with 4KB pages.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "bench.h"
+#include "allocator.h"
+#include "array_list.h"
+
+// 64M int64 items (512MB), and the number of lookups. With --max-size,
+// the number of items is the largest power of two within it (for the index mask)
+#define NUM_ITEMS (1 << 26)
+#define NUM_LOOKUPS (1 << 24)
+static int num_items;
+static int num_lookups;
+
+/*
+Fills a list, then times list_get at random indices
+(from a xorshift generator, so the indices are not precomputed)
+*/
+static void bench_random_access(const char *name, const allocator *alloc)
+{
+  list_p list = alloc ? list_create_ex(sizeof(int64_t), alloc) : list_create(sizeof(int64_t));
+  for (int64_t i = 0; i < num_items; i++)
+    list_append(list, &i);
+
+  uint64_t state = 88172645463325252ULL;
+  int64_t sum = 0;
+  double start = bench_now();
+  for (int i = 0; i < num_lookups; i++)
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int64_t value;
+    list_get(list, (int)(state & (num_items - 1)), &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+  bench_sink = sum;
+  bench_report("pages", name, num_lookups, elapsed);
+  list_delete(list);
+}
+
+void bench_allocator_pages(void)
+{
+  static const struct
+  {
+    const char *name;
+    int flags;
+  } configs[] = {
+      {"random list_get 4KB pages", PAGES_DEFAULT},
+      {"random list_get THP", PAGES_THP},
+      {"random list_get hugetlb (or THP)", PAGES_HUGETLB},
+      {"random list_get THP + NUMA bind", PAGES_THP | PAGES_NUMA_BIND},
+      {"random list_get THP + NUMA interleave", PAGES_THP | PAGES_NUMA_INTERLEAVE},
+  };
+
+  num_items = NUM_ITEMS;
+  while (num_items > bench_size(num_items))
+    num_items /= 2;
+  num_lookups = (int)bench_size(NUM_LOOKUPS);
+
+  bench_random_access("random list_get heap", NULL);
+  for (int c = 0; c < (int)(sizeof(configs) / sizeof(configs[0])); c++)
+  {
+    // All nodes (mbind ignores nodes which do not exist)
+    pages_p pages = pages_create(configs[c].flags, ~0UL);
+    allocator alloc = pages_allocator(pages);
+    bench_random_access(configs[c].name, &alloc);
+    pages_delete(pages);
+  }
+}
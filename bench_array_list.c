@@ -0,0 +1,312 @@
+/**
+ * Benchmarks for the array_list module
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "array_list.h"
+
+// Number of records loaded in the bulk append benchmarks (at most --max-size)
+#define NUM_RECORDS 10000000
+static int num_records;
+
+// Number of records inserted at the front in the bulk insert benchmarks
+#define NUM_FRONT_INSERTS 20000
+static int num_front_inserts;
+
+// Approximate number of bytes shifted per timed run of the shift benchmarks
+// (the number of operations shrinks as the list size grows)
+#define SHIFT_BYTES_PER_RUN (1L << 28)
+#define MIN_SHIFT_OPS 10
+#define MAX_SHIFT_OPS 1000000
+
+// Largest list for the looped list_remove comparison in the remove half
+// benchmarks (removing half of a list one item at a time is quadratic)
+#define MAX_LOOPED_REMOVE 100000
+
+/*
+Name of a benchmark with its number of records, e.g. "list_append_n (10000000)"
+(in a static buffer, which is overwritten by the next call)
+*/
+static const char *sized_name(const char *name, int count)
+{
+  static char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%s (%d)", name, count);
+  return buffer;
+}
+
+static void bench_looped_append(const int *records)
+{
+  list_p list = list_create(sizeof(int));
+
+  double start = bench_now();
+  for (int i = 0; i < num_records; i++)
+    list_append(list, (void *)&records[i]);
+  double elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  bench_report("array_list", sized_name("looped list_append", num_records), num_records, elapsed);
+  list_delete(list);
+}
+
+static void bench_append_n(const int *records)
+{
+  list_p list = list_create(sizeof(int));
+
+  double start = bench_now();
+  list_append_n(list, records, num_records);
+  double elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  bench_report("array_list", sized_name("list_append_n", num_records), num_records, elapsed);
+  list_delete(list);
+}
+
+static void bench_looped_insert_front(const int *records)
+{
+  list_p list = list_create(sizeof(int));
+
+  // Inserting records in reverse at index 0 gives the same order as list_insert_n
+  double start = bench_now();
+  for (int i = num_front_inserts - 1; i >= 0; i--)
+    list_insert(list, (void *)&records[i], 0);
+  double elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  bench_report("array_list", sized_name("looped list_insert at 0", num_front_inserts), num_front_inserts, elapsed);
+  list_delete(list);
+}
+
+static void bench_insert_n_front(const int *records)
+{
+  list_p list = list_create(sizeof(int));
+
+  double start = bench_now();
+  list_insert_n(list, records, num_front_inserts, 0);
+  double elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  bench_report("array_list", sized_name("list_insert_n at 0", num_front_inserts), num_front_inserts, elapsed);
+  list_delete(list);
+}
+
+/*
+Number of operations for a shift benchmark on a list of size elements
+*/
+static long shift_ops(int size)
+{
+  long ops = SHIFT_BYTES_PER_RUN / ((long)size * sizeof(int));
+  if (ops < MIN_SHIFT_OPS)
+    return MIN_SHIFT_OPS;
+  if (ops > MAX_SHIFT_OPS)
+    return MAX_SHIFT_OPS;
+  return ops;
+}
+
+/*
+Latency of list_insert and list_remove at a list size of size elements.
+Each timed operation is paired with a cheap operation at the end of the
+list (remove or append) so that the size stays the same throughout.
+*/
+static void bench_shift_latency(const int *records, int size)
+{
+  list_p list = list_create(sizeof(int));
+  list_append_n(list, records, size);
+  long ops = shift_ops(size);
+  int value = 0;
+  char name[64];
+
+  double start = bench_now();
+  for (long i = 0; i < ops; i++)
+  {
+    list_insert(list, &value, 0);
+    list_remove(list, size);
+  }
+  double elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "list_insert at front (size %d)", size);
+  bench_report("array_list", name, ops, elapsed);
+
+  start = bench_now();
+  for (long i = 0; i < ops; i++)
+  {
+    list_insert(list, &value, size / 2);
+    list_remove(list, size);
+  }
+  elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "list_insert at middle (size %d)", size);
+  bench_report("array_list", name, ops, elapsed);
+
+  start = bench_now();
+  for (long i = 0; i < ops; i++)
+  {
+    list_remove(list, 0);
+    list_append(list, &value);
+  }
+  elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "list_remove at front (size %d)", size);
+  bench_report("array_list", name, ops, elapsed);
+
+  bench_sink = list_size(list);
+  list_delete(list);
+}
+
+/*
+Full read-only scan of a num_records element list through list_get, list_at
+and list_data_span
+*/
+static void bench_scan(const int *records)
+{
+  list_p list = list_create(sizeof(int));
+  list_append_n(list, records, num_records);
+  long sum = 0;
+  int value;
+
+  double start = bench_now();
+  for (int i = 0; i < num_records; i++)
+  {
+    list_get(list, i, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+  bench_report("array_list", sized_name("scan via list_get", num_records), num_records, elapsed);
+
+  start = bench_now();
+  for (int i = 0; i < num_records; i++)
+    sum += *(const int *)list_at(list, i);
+  elapsed = bench_now() - start;
+  bench_report("array_list", sized_name("scan via list_at", num_records), num_records, elapsed);
+
+  start = bench_now();
+  const void *data;
+  int length;
+  list_data_span(list, &data, &length);
+  const int *items = data;
+  for (int i = 0; i < length; i++)
+    sum += items[i];
+  elapsed = bench_now() - start;
+  bench_report("array_list", sized_name("scan via list_data_span", num_records), num_records, elapsed);
+
+  bench_sink = sum;
+  list_delete(list);
+}
+
+/*
+Throughput of removing items at random indices of a list of size
+elements, with list_remove on an ordered list (shifting the tail) and
+on an unordered list (list_create_unordered, moving the last item).
+Up to half of the list is removed; the ordered path removes fewer items
+at large sizes (as for the shift benchmarks)
+*/
+static void bench_random_remove(const int *records, int size)
+{
+  char name[64];
+  const char *kind[] = {"ordered", "unordered"};
+  for (int unordered = 0; unordered < 2; unordered++)
+  {
+    list_p list = unordered ? list_create_unordered(sizeof(int)) : list_create(sizeof(int));
+    list_append_n(list, records, size);
+    long ops = size / 2;
+    if (!unordered && shift_ops(size) < ops)
+      ops = shift_ops(size);
+
+    double start = bench_now();
+    for (long i = 0; i < ops; i++)
+      list_remove(list, (int)(bench_rand() % (uint64_t)list_size(list)));
+    double elapsed = bench_now() - start;
+
+    bench_sink = list_size(list);
+    snprintf(name, sizeof(name), "random list_remove, %s (size %d)", kind[unordered], size);
+    bench_report("array_list", name, ops, elapsed);
+    list_delete(list);
+  }
+}
+
+static bool is_odd(const void *value, void *ctx)
+{
+  (void)ctx;
+  return *(const int *)value & 1;
+}
+
+/*
+Removing every other item (50%) of a list of size elements, with
+list_remove_if (one compaction pass) and with looped list_remove
+*/
+static void bench_remove_half(const int *records, int size)
+{
+  char name[64];
+  list_p list = list_create(sizeof(int));
+  list_append_n(list, records, size);
+
+  double start = bench_now();
+  int removed = list_remove_if(list, is_odd, NULL);
+  double elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  snprintf(name, sizeof(name), "remove half via list_remove_if (%d)", size);
+  bench_report("array_list", name, removed, elapsed);
+  list_delete(list);
+
+  if (size > MAX_LOOPED_REMOVE)
+    return;
+
+  list = list_create(sizeof(int));
+  list_append_n(list, records, size);
+
+  // Removing index i moves the next item (which is kept) to i
+  start = bench_now();
+  for (int i = 0; i < list_size(list); i++)
+    list_remove(list, i);
+  elapsed = bench_now() - start;
+
+  bench_sink = list_size(list);
+  snprintf(name, sizeof(name), "remove half via looped list_remove (%d)", size);
+  bench_report("array_list", name, size - list_size(list), elapsed);
+  list_delete(list);
+}
+
+void bench_array_list(void)
+{
+  num_records = (int)bench_size(NUM_RECORDS);
+  num_front_inserts = (int)bench_size(NUM_FRONT_INSERTS);
+  int *records = malloc(num_records * sizeof(int));
+  for (int i = 0; i < num_records; i++)
+    records[i] = i;
+
+  bench_looped_append(records);
+  bench_append_n(records);
+  bench_looped_insert_front(records);
+  bench_insert_n_front(records);
+  bench_scan(records);
+
+  // List sizes from 16 to 10M elements. Each loop stops after the
+  // first size which is limited by --max-size
+  const int sizes[] = {16, 256, 4096, 65536, 1 << 20, NUM_RECORDS};
+  for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+  {
+    int size = (int)bench_size(sizes[i]);
+    bench_shift_latency(records, size);
+    if (size < sizes[i])
+      break;
+  }
+
+  const int remove_sizes[] = {10000, MAX_LOOPED_REMOVE, 1000000, NUM_RECORDS};
+  for (int i = 0; i < (int)(sizeof(remove_sizes) / sizeof(remove_sizes[0])); i++)
+  {
+    int size = (int)bench_size(remove_sizes[i]);
+    bench_remove_half(records, size);
+    if (size < remove_sizes[i])
+      break;
+  }
+
+  for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+  {
+    int size = (int)bench_size(sizes[i]);
+    bench_random_remove(records, size);
+    if (size < sizes[i])
+      break;
+  }
+
+  free(records);
+}
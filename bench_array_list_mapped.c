@@ -0,0 +1,95 @@
+/**
+ * Benchmarks for memory-mapped (file-backed) lists against heap lists:
+ * append throughput, and the time to reopen a saved list
+ * (mapping the file, versus reading it into a heap list)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "bench.h"
+#include "array_list.h"
+
+#define BENCH_PATH "/tmp/bench_array_list_mapped.dsl"
+#define HEAP_PATH "/tmp/bench_array_list_heap.bin"
+
+static const int sizes[] = {1 << 16, 1 << 20, 1 << 24};
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+void bench_array_list_mapped(void)
+{
+  char name[64];
+
+  for (int s = 0; s < NUM_SIZES; s++)
+  {
+    // Stop after the first size which is limited by --max-size
+    if (s > 0 && bench_size(sizes[s - 1]) < sizes[s - 1])
+      break;
+    int n = (int)bench_size(sizes[s]);
+
+    // Append to a heap list, and save it with fwrite
+    double start = bench_now();
+    list_p list = list_create(sizeof(int64_t));
+    for (int64_t i = 0; i < n; i++)
+      list_append(list, &i);
+    double elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "append heap n=%d", n);
+    bench_report("list_mapped", name, n, elapsed);
+
+    FILE *file = fopen(HEAP_PATH, "wb");
+    fwrite(&n, sizeof(n), 1, file);
+    fwrite(list_at(list, 0), sizeof(int64_t), n, file);
+    fclose(file);
+    list_delete(list);
+
+    // Append to a new mapped list, and save it with list_delete
+    unlink(BENCH_PATH);
+    start = bench_now();
+    list = list_create_mapped(BENCH_PATH, sizeof(int64_t));
+    for (int64_t i = 0; i < n; i++)
+      list_append(list, &i);
+    list_delete(list);
+    elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "append mapped n=%d", n);
+    bench_report("list_mapped", name, n, elapsed);
+
+    // Reopen, then sum the items (the mapped list pages them in on first touch)
+    start = bench_now();
+    int count;
+    file = fopen(HEAP_PATH, "rb");
+    size_t got = fread(&count, sizeof(count), 1, file);
+    list = list_create_with_capacity(sizeof(int64_t), count);
+    int64_t buffer[4096];
+    while (got && (got = fread(buffer, sizeof(int64_t), 4096, file)) > 0)
+      list_append_n(list, buffer, (int)got);
+    fclose(file);
+    double opened = bench_now() - start;
+    long sum = 0;
+    for (int i = 0; i < list_size(list); i++)
+      sum += *(const int64_t *)list_at(list, i);
+    elapsed = bench_now() - start;
+    list_delete(list);
+    snprintf(name, sizeof(name), "reopen heap (fread) n=%d", n);
+    bench_report("list_mapped", name, n, opened);
+    snprintf(name, sizeof(name), "reopen+scan heap (fread) n=%d", n);
+    bench_report("list_mapped", name, n, elapsed);
+
+    start = bench_now();
+    list = list_create_mapped(BENCH_PATH, sizeof(int64_t));
+    opened = bench_now() - start;
+    for (int i = 0; i < list_size(list); i++)
+      sum += *(const int64_t *)list_at(list, i);
+    elapsed = bench_now() - start;
+    list_delete(list);
+    snprintf(name, sizeof(name), "reopen mapped n=%d", n);
+    bench_report("list_mapped", name, n, opened);
+    snprintf(name, sizeof(name), "reopen+scan mapped n=%d", n);
+    bench_report("list_mapped", name, n, elapsed);
+
+    bench_sink = sum;
+    unlink(BENCH_PATH);
+    unlink(HEAP_PATH);
+  }
+}
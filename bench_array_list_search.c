@@ -0,0 +1,79 @@
+/**
+ * Lookup latency benchmarks for the array_list binary search functions,
+ * at list sizes from L1 cache to DRAM
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "bench.h"
+#include "array_list.h"
+
+// Sorted int32 lists from 4KB (L1) to 256MB (DRAM)
+static const int sizes[] = {1 << 10, 1 << 13, 1 << 16, 1 << 19, 1 << 22, 1 << 26};
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+// Number of lookups per run (at most --max-size), and the number of
+// random keys they cycle through
+#define NUM_LOOKUPS (1 << 21)
+#define NUM_KEYS (1 << 16)
+
+static int compare_i32(const void *a, const void *b)
+{
+  int32_t x = *(const int32_t *)a;
+  int32_t y = *(const int32_t *)b;
+  return (x > y) - (x < y);
+}
+
+void bench_array_list_search(void)
+{
+  int num_lookups = (int)bench_size(NUM_LOOKUPS);
+  int32_t *keys = malloc(NUM_KEYS * sizeof(int32_t));
+  char name[64];
+
+  for (int s = 0; s < NUM_SIZES; s++)
+  {
+    // Stop after the first size which is limited by --max-size
+    if (s > 0 && bench_size(sizes[s - 1]) < sizes[s - 1])
+      break;
+    int n = (int)bench_size(sizes[s]);
+    // Odd values, so half of the lookups (the even keys) miss
+    list_p list = list_create_with_capacity(sizeof(int32_t), n);
+    for (int32_t i = 0; i < n; i++)
+    {
+      int32_t value = 2 * i + 1;
+      list_append(list, &value);
+    }
+    for (int i = 0; i < NUM_KEYS; i++)
+      keys[i] = (int32_t)(((uint32_t)rand() << 16 ^ (uint32_t)rand()) % (2u * n));
+    list_eytzinger_p index = list_eytzinger_create(list, compare_i32);
+    long sum = 0;
+
+    double start = bench_now();
+    for (int i = 0; i < num_lookups; i++)
+      sum += list_lower_bound(list, &keys[i & (NUM_KEYS - 1)], compare_i32);
+    double elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "lower_bound n=%d", n);
+    bench_report("list_search", name, num_lookups, elapsed);
+
+    start = bench_now();
+    for (int i = 0; i < num_lookups; i++)
+      sum += list_lower_bound_branchless(list, &keys[i & (NUM_KEYS - 1)], compare_i32);
+    elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "lower_bound_branchless n=%d", n);
+    bench_report("list_search", name, num_lookups, elapsed);
+
+    start = bench_now();
+    for (int i = 0; i < num_lookups; i++)
+      sum += list_eytzinger_lower_bound(index, &keys[i & (NUM_KEYS - 1)]);
+    elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "eytzinger_lower_bound n=%d", n);
+    bench_report("list_search", name, num_lookups, elapsed);
+
+    bench_sink = sum;
+    list_eytzinger_delete(index);
+    list_delete(list);
+  }
+  free(keys);
+}
@@ -0,0 +1,111 @@
+/**
+ * Throughput benchmarks for the array_list search, fill and reduction
+ * functions at each instruction set level supported by the CPU
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "bench.h"
+#include "array_list_simd_p.h"
+
+// Number of items in each list (at most --max-size)
+#define NUM_ITEMS 10000000
+static int num_items;
+
+// Number of passes over the list per benchmark
+#define NUM_PASSES 10
+
+static const char *level_names[] = {"scalar", "SSE2", "AVX2"};
+
+static void bench_level(list_p list32, list_p list64, list_p listf, list_p listd, int level)
+{
+  char name[64];
+  long ops = (long)num_items * NUM_PASSES;
+  int32_t absent = -1;
+  int32_t key = 3;
+  long result = 0;
+
+  _simd_set_level((_simd_level_t)level);
+
+  double start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += list_find(list32, &absent);
+  snprintf(name, sizeof(name), "list_find int32 (miss) [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += list_count(list32, &key);
+  snprintf(name, sizeof(name), "list_count int32 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += list_sum_i32(list32);
+  snprintf(name, sizeof(name), "list_sum_i32 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += list_max_i32(list32);
+  snprintf(name, sizeof(name), "list_max_i32 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += list_min_i64(list64);
+  snprintf(name, sizeof(name), "list_min_i64 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += (long)list_sum_f32(listf);
+  snprintf(name, sizeof(name), "list_sum_f32 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    result += (long)list_max_f64(listd);
+  snprintf(name, sizeof(name), "list_max_f64 [%s]", level_names[level]);
+  bench_report("list_simd", name, ops, bench_now() - start);
+
+  bench_sink = result;
+}
+
+void bench_array_list_simd(void)
+{
+  num_items = (int)bench_size(NUM_ITEMS);
+  list_p list32 = list_create_with_capacity(sizeof(int32_t), num_items);
+  list_p list64 = list_create_with_capacity(sizeof(int64_t), num_items);
+  list_p listf = list_create_with_capacity(sizeof(float), num_items);
+  list_p listd = list_create_with_capacity(sizeof(double), num_items);
+
+  for (int i = 0; i < num_items; i++)
+  {
+    int32_t v32 = i % 1000;
+    int64_t v64 = i;
+    float vf = (float)(i % 1000);
+    double vd = i;
+    list_append(list32, &v32);
+    list_append(list64, &v64);
+    list_append(listf, &vf);
+    list_append(listd, &vd);
+  }
+
+  _simd_level_t max_level = _simd_max_level();
+  for (int level = SIMD_SCALAR; level <= (int)max_level; level++)
+    bench_level(list32, list64, listf, listd, level);
+  _simd_set_level(max_level);
+
+  int32_t value = 7;
+  double start = bench_now();
+  for (int pass = 0; pass < NUM_PASSES; pass++)
+    list_fill(list32, &value);
+  bench_report("list_simd", "list_fill int32", (long)num_items * NUM_PASSES, bench_now() - start);
+
+  list_delete(list32);
+  list_delete(list64);
+  list_delete(listf);
+  list_delete(listd);
+}
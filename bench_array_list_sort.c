@@ -0,0 +1,124 @@
+/**
+ * Benchmarks for the array_list sort functions, compared against
+ * qsort on the same buffer
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "bench.h"
+#include "array_list.h"
+
+// List sizes (100M int32 needs about 1.2GB: the list, its copy and the sort buffer)
+static const int sizes[] = {1000000, 10000000, 100000000};
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+static int compare_i32(const void *a, const void *b)
+{
+  int32_t x = *(const int32_t *)a;
+  int32_t y = *(const int32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static int compare_f64(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+enum sort_kind
+{
+  SORT_QSORT,
+  SORT_LIST,
+  SORT_STABLE,
+  SORT_RADIX
+};
+
+static const char *sort_names[] = {"qsort", "list_sort", "list_stable_sort", "list_radix_sort"};
+
+/*
+Sorts a copy of the random values in source with each method, checking the
+result is in order. The copy is made outside the timed region
+*/
+static void bench_sorts(list_p source, const char *type_name, list_compare_fn cmp, list_key_type key)
+{
+  const void *values;
+  int n;
+  list_data_span(source, &values, &n);
+  size_t element_size = key == LIST_KEY_F64 ? sizeof(double) : sizeof(int32_t);
+  list_p list = list_create_with_capacity(element_size, n);
+  list_append_n(list, values, n);
+  char name[64];
+
+  for (enum sort_kind kind = SORT_QSORT; kind <= SORT_RADIX; kind++)
+  {
+    const void *data;
+    int length;
+    list_data_span(list, &data, &length);
+    memcpy((void *)data, values, (size_t)n * element_size);
+
+    double start = bench_now();
+    switch (kind)
+    {
+    case SORT_QSORT:
+      qsort((void *)data, length, element_size, cmp);
+      break;
+    case SORT_LIST:
+      list_sort(list, cmp);
+      break;
+    case SORT_STABLE:
+      list_stable_sort(list, cmp);
+      break;
+    case SORT_RADIX:
+      list_radix_sort(list, key);
+      break;
+    }
+    double elapsed = bench_now() - start;
+
+    for (int i = 1; i < length; i++)
+    {
+      if (cmp(list_at(list, i - 1), list_at(list, i)) > 0)
+      {
+        fprintf(stderr, "list_sort: %s result not sorted at %d\n", sort_names[kind], i);
+        break;
+      }
+    }
+    snprintf(name, sizeof(name), "%s %s n=%d", sort_names[kind], type_name, n);
+    bench_report("list_sort", name, n, elapsed);
+  }
+  list_delete(list);
+}
+
+void bench_array_list_sort(void)
+{
+  for (int s = 0; s < NUM_SIZES; s++)
+  {
+    // Stop after the first size which is limited by --max-size
+    if (s > 0 && bench_size(sizes[s - 1]) < sizes[s - 1])
+      break;
+    int n = (int)bench_size(sizes[s]);
+    list_p source = list_create_with_capacity(sizeof(int32_t), n);
+    for (int i = 0; i < n; i++)
+    {
+      int32_t value = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+      list_append(source, &value);
+    }
+    bench_sorts(source, "int32", compare_i32, LIST_KEY_I32);
+    list_delete(source);
+
+    // The double runs stop at 10M to bound the memory used
+    if (n > 10000000)
+      continue;
+    source = list_create_with_capacity(sizeof(double), n);
+    for (int i = 0; i < n; i++)
+    {
+      double value = (double)rand() / RAND_MAX * 2e6 - 1e6;
+      list_append(source, &value);
+    }
+    bench_sorts(source, "double", compare_f64, LIST_KEY_F64);
+    list_delete(source);
+  }
+}
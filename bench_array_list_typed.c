@@ -0,0 +1,138 @@
+/**
+ * Benchmarks for the typed array lists against the generic list_p
+ *
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "array_list.h"
+#include "array_list_typed.h"
+
+DEFINE_ARRAY_LIST(int)
+DEFINE_ARRAY_LIST(double)
+
+// Number of elements per benchmark
+#define NUM_OPS 10000000
+static int num_ops;
+
+static void bench_generic_int(void)
+{
+  list_p list = list_create(sizeof(int));
+  long sum = 0;
+  int value;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    list_append(list, &i);
+  bench_report("typed_list", "generic list_p<int> append", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    list_get(list, i, &value);
+    sum += value;
+  }
+  bench_report("typed_list", "generic list_p<int> get", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    value = i * 3;
+    list_set(list, &value, i);
+  }
+  bench_report("typed_list", "generic list_p<int> set", num_ops, bench_now() - start);
+
+  bench_sink = sum;
+  list_delete(list);
+}
+
+static void bench_typed_int(void)
+{
+  list_int_p list = list_int_create();
+  long sum = 0;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    list_int_append(list, i);
+  bench_report("typed_list", "list_int append", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    sum += list_int_get(list, i);
+  bench_report("typed_list", "list_int get", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    list_int_set(list, i * 3, i);
+  bench_report("typed_list", "list_int set", num_ops, bench_now() - start);
+
+  bench_sink = sum + list_int_get(list, num_ops - 1);
+  list_int_delete(list);
+}
+
+static void bench_generic_double(void)
+{
+  list_p list = list_create(sizeof(double));
+  double sum = 0;
+  double value;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    value = i;
+    list_append(list, &value);
+  }
+  bench_report("typed_list", "generic list_p<double> append", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    list_get(list, i, &value);
+    sum += value;
+  }
+  bench_report("typed_list", "generic list_p<double> get", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    value = i * 0.5;
+    list_set(list, &value, i);
+  }
+  bench_report("typed_list", "generic list_p<double> set", num_ops, bench_now() - start);
+
+  bench_sink = (long)sum;
+  list_delete(list);
+}
+
+static void bench_typed_double(void)
+{
+  list_double_p list = list_double_create();
+  double sum = 0;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    list_double_append(list, i);
+  bench_report("typed_list", "list_double append", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    sum += list_double_get(list, i);
+  bench_report("typed_list", "list_double get", num_ops, bench_now() - start);
+
+  start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    list_double_set(list, i * 0.5, i);
+  bench_report("typed_list", "list_double set", num_ops, bench_now() - start);
+
+  bench_sink = (long)(sum + list_double_get(list, num_ops - 1));
+  list_double_delete(list);
+}
+
+void bench_array_list_typed(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  bench_generic_int();
+  bench_typed_int();
+  bench_generic_double();
+  bench_typed_double();
+}
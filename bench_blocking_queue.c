@@ -0,0 +1,152 @@
+/**
+ * Benchmarks for the blocking queue module: throughput with several
+ * producers and consumers, and the latency of waking a sleeping consumer
+ *
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bench.h"
+#include "blocking_queue.h"
+
+// Total number of items passed from producers to consumers
+#define NUM_OPS (1 << 20)
+static int num_ops;
+
+#define CAPACITY 1024
+
+// Number of wakeups measured, and the pause between them (so that
+// the consumers are asleep again before the next push)
+#define NUM_WAKEUPS 2000
+static int num_wakeups;
+#define WAKEUP_INTERVAL_US 200
+
+/*
+State shared by the threads of one run
+*/
+struct run
+{
+  blocking_queue_p queue;
+  pthread_barrier_t start;
+  int items_per_producer;
+};
+
+static void *producer(void *arg)
+{
+  struct run *run = arg;
+  pthread_barrier_wait(&run->start);
+  for (int i = 0; i < run->items_per_producer; i++)
+    blocking_queue_push(run->queue, &i);
+  return NULL;
+}
+
+static void *consumer(void *arg)
+{
+  struct run *run = arg;
+  int value;
+  long sum = 0;
+  pthread_barrier_wait(&run->start);
+  while (blocking_queue_pop(run->queue, &value) == BLOCKING_QUEUE_OK)
+    sum += value;
+  bench_sink = sum;
+  return NULL;
+}
+
+static void bench_throughput(int threads)
+{
+  struct run run;
+  int producers = threads / 2;
+  int consumers = threads - producers;
+  pthread_t ids[threads];
+  char name[64];
+
+  run.queue = blocking_queue_create(sizeof(int), CAPACITY);
+  run.items_per_producer = num_ops / producers;
+  pthread_barrier_init(&run.start, NULL, threads + 1);
+  for (int i = 0; i < threads; i++)
+    pthread_create(&ids[i], NULL, i < producers ? producer : consumer, &run);
+
+  pthread_barrier_wait(&run.start);
+  double start = bench_now();
+  for (int i = 0; i < producers; i++)
+    pthread_join(ids[i], NULL);
+  blocking_queue_close(run.queue);
+  for (int i = producers; i < threads; i++)
+    pthread_join(ids[i], NULL);
+  double elapsed = bench_now() - start;
+
+  snprintf(name, sizeof(name), "push+pop, %d producers/%d consumers", producers, consumers);
+  bench_report("blocking_queue", name, (long)producers * run.items_per_producer, elapsed);
+  pthread_barrier_destroy(&run.start);
+  blocking_queue_delete(run.queue);
+}
+
+/*
+Each consumer sleeps in pop; the value popped is the time it was pushed
+*/
+struct wakeup_run
+{
+  blocking_queue_p queue;
+  pthread_mutex_t lock;
+  double total_latency;
+  long wakeups;
+};
+
+static void *wakeup_consumer(void *arg)
+{
+  struct wakeup_run *run = arg;
+  double pushed;
+  while (blocking_queue_pop(run->queue, &pushed) == BLOCKING_QUEUE_OK)
+  {
+    double latency = bench_now() - pushed;
+    pthread_mutex_lock(&run->lock);
+    run->total_latency += latency;
+    run->wakeups++;
+    pthread_mutex_unlock(&run->lock);
+  }
+  return NULL;
+}
+
+static void bench_wakeup(int threads)
+{
+  struct wakeup_run run;
+  int consumers = threads - 1;
+  pthread_t ids[consumers];
+  char name[64];
+
+  run.queue = blocking_queue_create(sizeof(double), 0);
+  pthread_mutex_init(&run.lock, NULL);
+  run.total_latency = 0;
+  run.wakeups = 0;
+  for (int i = 0; i < consumers; i++)
+    pthread_create(&ids[i], NULL, wakeup_consumer, &run);
+
+  usleep(10000);
+  for (int i = 0; i < num_wakeups; i++)
+  {
+    double now = bench_now();
+    blocking_queue_push(run.queue, &now);
+    usleep(WAKEUP_INTERVAL_US);
+  }
+  blocking_queue_close(run.queue);
+  for (int i = 0; i < consumers; i++)
+    pthread_join(ids[i], NULL);
+
+  // ns/op is the mean time from push to the consumer returning from pop
+  snprintf(name, sizeof(name), "wakeup latency, %d sleeping consumers", consumers);
+  bench_report("blocking_queue", name, run.wakeups, run.total_latency);
+  pthread_mutex_destroy(&run.lock);
+  blocking_queue_delete(run.queue);
+}
+
+void bench_blocking_queue(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  num_wakeups = (int)bench_size(NUM_WAKEUPS);
+  int thread_counts[] = {4, 16, 64};
+  for (int i = 0; i < 3; i++)
+    bench_throughput(thread_counts[i]);
+  for (int i = 0; i < 3; i++)
+    bench_wakeup(thread_counts[i]);
+}
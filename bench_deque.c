@@ -0,0 +1,77 @@
+/**
+ * Benchmarks for the deque module: front-insert workloads
+ * compared against list_insert/list_remove at index 0
+ *
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "deque.h"
+#include "array_list.h"
+
+// Sizes of the front-insert runs; the list is only run up to LIST_MAX_SIZE
+// as each insert at index 0 moves every element (quadratic overall)
+static const int sizes[] = {1000, 10000, 100000, 1000000};
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+#define LIST_MAX_SIZE 100000
+
+static void bench_deque_front(int size)
+{
+  deque_p deque = deque_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+  char name[64];
+
+  double start = bench_now();
+  for (int i = 0; i < size; i++)
+    deque_push_front(deque, &i);
+  for (int i = 0; i < size; i++)
+  {
+    deque_pop_front(deque, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  snprintf(name, sizeof(name), "deque push_front+pop_front, n=%d", size);
+  bench_report("deque", name, 2L * size, elapsed);
+  deque_delete(deque);
+}
+
+static void bench_list_front(int size)
+{
+  list_p list = list_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+  char name[64];
+
+  double start = bench_now();
+  for (int i = 0; i < size; i++)
+    list_insert(list, &i, 0);
+  for (int i = 0; i < size; i++)
+  {
+    list_get(list, 0, &value);
+    list_remove(list, 0);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  snprintf(name, sizeof(name), "list insert/remove at 0, n=%d", size);
+  bench_report("deque", name, 2L * size, elapsed);
+  list_delete(list);
+}
+
+void bench_deque(void)
+{
+  for (int i = 0; i < NUM_SIZES; i++)
+  {
+    // Stop after the first size which is limited by --max-size
+    if (i > 0 && bench_size(sizes[i - 1]) < sizes[i - 1])
+      break;
+    int size = (int)bench_size(sizes[i]);
+    bench_deque_front(size);
+    if (size <= LIST_MAX_SIZE)
+      bench_list_front(size);
+  }
+}
@@ -0,0 +1,164 @@
+/**
+ * Scaling benchmarks for the mpmc queue module,
+ * compared against the linked queue protected by a mutex
+ *
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include "bench.h"
+#include "queue.h"
+#include "mpmc_queue.h"
+
+// Total number of items passed from producers to consumers
+#define NUM_OPS (1 << 21)
+static int num_ops;
+
+#define CAPACITY 1024
+
+/*
+State shared by the producer and consumer threads of one run
+*/
+struct run
+{
+  mpmc_queue_p queue;       // used by the mpmc runs
+  queue_p locked_queue;     // used by the mutex runs
+  int locked_length;
+  pthread_mutex_t lock;
+  pthread_barrier_t start;
+  int items_per_thread;
+};
+
+static void *mpmc_producer(void *arg)
+{
+  struct run *run = arg;
+  pthread_barrier_wait(&run->start);
+  for (int i = 0; i < run->items_per_thread; i++)
+    mpmc_queue_enqueue(run->queue, &i);
+  return NULL;
+}
+
+static void *mpmc_consumer(void *arg)
+{
+  struct run *run = arg;
+  int value;
+  long sum = 0;
+  pthread_barrier_wait(&run->start);
+  for (int i = 0; i < run->items_per_thread; i++)
+  {
+    mpmc_queue_dequeue(run->queue, &value);
+    sum += value;
+  }
+  bench_sink = sum;
+  return NULL;
+}
+
+static void *locked_producer(void *arg)
+{
+  struct run *run = arg;
+  pthread_barrier_wait(&run->start);
+  for (int i = 0; i < run->items_per_thread; i++)
+  {
+    pthread_mutex_lock(&run->lock);
+    queue_enqueue(run->locked_queue, &i);
+    run->locked_length++;
+    pthread_mutex_unlock(&run->lock);
+  }
+  return NULL;
+}
+
+static void *locked_consumer(void *arg)
+{
+  struct run *run = arg;
+  int value;
+  long sum = 0;
+  pthread_barrier_wait(&run->start);
+  for (int i = 0; i < run->items_per_thread; i++)
+  {
+    bool got = false;
+    while (!got)
+    {
+      pthread_mutex_lock(&run->lock);
+      if (run->locked_length > 0)
+      {
+        queue_dequeue(run->locked_queue, &value);
+        run->locked_length--;
+        got = true;
+      }
+      pthread_mutex_unlock(&run->lock);
+      if (!got)
+        sched_yield();
+    }
+    sum += value;
+  }
+  bench_sink = sum;
+  return NULL;
+}
+
+/*
+Run threads producers and threads consumers passing num_ops items in total
+*/
+static double timed_run(struct run *run, int threads,
+                        void *(*producer)(void *), void *(*consumer)(void *))
+{
+  pthread_t producers[threads];
+  pthread_t consumers[threads];
+
+  run->items_per_thread = num_ops / threads;
+  pthread_barrier_init(&run->start, NULL, 2 * threads + 1);
+  for (int i = 0; i < threads; i++)
+  {
+    pthread_create(&producers[i], NULL, producer, run);
+    pthread_create(&consumers[i], NULL, consumer, run);
+  }
+
+  pthread_barrier_wait(&run->start);
+  double start = bench_now();
+  for (int i = 0; i < threads; i++)
+  {
+    pthread_join(producers[i], NULL);
+    pthread_join(consumers[i], NULL);
+  }
+  double elapsed = bench_now() - start;
+
+  pthread_barrier_destroy(&run->start);
+  return elapsed;
+}
+
+void bench_mpmc_queue(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  char name[64];
+
+  // Double the number of threads on each side up to the number of cores
+  for (int threads = 1;; threads *= 2)
+  {
+    if (threads > max_threads)
+      threads = max_threads;
+
+    struct run run;
+    int ops = num_ops / threads * threads;
+
+    run.queue = mpmc_queue_create(sizeof(int), CAPACITY);
+    double elapsed = timed_run(&run, threads, mpmc_producer, mpmc_consumer);
+    snprintf(name, sizeof(name), "mpmc %dP/%dC", threads, threads);
+    bench_report("mpmc_queue", name, ops, elapsed);
+    mpmc_queue_delete(run.queue);
+
+    run.locked_queue = queue_create(sizeof(int));
+    run.locked_length = 0;
+    pthread_mutex_init(&run.lock, NULL);
+    elapsed = timed_run(&run, threads, locked_producer, locked_consumer);
+    snprintf(name, sizeof(name), "mutex+linked queue %dP/%dC", threads, threads);
+    bench_report("mpmc_queue", name, ops, elapsed);
+    pthread_mutex_destroy(&run.lock);
+    queue_delete(run.locked_queue);
+
+    if (threads == max_threads)
+      break;
+  }
+}
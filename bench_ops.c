@@ -0,0 +1,228 @@
+/**
+ * Benchmarks of the basic list and queue operations (append, insert, get,
+ * set, remove, enqueue, dequeue) for element sizes of 4 to 256 bytes and
+ * structure sizes from 1000 items up to --max-size (10M by default, at
+ * most 100M).
+ * Each benchmark has warmup and repeated runs (bench_run), and random
+ * indices come from the seeded generator, so results can be compared
+ * between commits.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "array_list.h"
+#include "queue.h"
+
+static const size_t element_sizes[] = {4, 16, 64, 256};
+static const long sizes[] = {1000, 100000, 1000000, 10000000, 100000000};
+#define NUM_ELEMENT_SIZES (int)(sizeof(element_sizes) / sizeof(element_sizes[0]))
+#define NUM_SIZES (int)(sizeof(sizes) / sizeof(sizes[0]))
+
+// Structures larger than this are skipped (so the default run fits in memory)
+#define MAX_BYTES (1L << 30)
+
+// Small structures are rebuilt until a run has at least this many operations
+#define MIN_OPS (1 << 20)
+
+// The number of random indices, and of get/set operations per run
+#define NUM_INDICES (1 << 20)
+
+// MIN_OPS and NUM_INDICES, limited by --max-size
+static int min_ops;
+static int num_indices;
+
+// Inserts and removes per run are chosen to move about this many bytes in total
+#define MOVE_BYTES (256L << 20)
+
+typedef struct ops_ctx
+{
+  size_t element_size;
+  int n;        // the size of the structure
+  int rounds;   // structures built (or insert/remove batches) per run
+  int count;    // operations per run or batch (get, set, insert, remove)
+  list_p list;  // a list of n items (get, set, insert, remove)
+  int *indices; // random indices in [0, n)
+  char value[256];
+} ops_ctx;
+
+static double run_append(void *arg)
+{
+  ops_ctx *ctx = arg;
+  double elapsed = 0;
+  for (int r = 0; r < ctx->rounds; r++)
+  {
+    list_p list = list_create(ctx->element_size);
+    double start = bench_now();
+    for (int i = 0; i < ctx->n; i++)
+      list_append(list, ctx->value);
+    elapsed += bench_now() - start;
+    list_delete(list);
+  }
+  return elapsed;
+}
+
+static double run_get(void *arg)
+{
+  ops_ctx *ctx = arg;
+  char out[256];
+  long sum = 0;
+  double start = bench_now();
+  for (int i = 0; i < ctx->count; i++)
+  {
+    list_get(ctx->list, ctx->indices[i], out);
+    sum += out[0];
+  }
+  double elapsed = bench_now() - start;
+  bench_sink = sum;
+  return elapsed;
+}
+
+static double run_set(void *arg)
+{
+  ops_ctx *ctx = arg;
+  double start = bench_now();
+  for (int i = 0; i < ctx->count; i++)
+    list_set(ctx->list, ctx->value, ctx->indices[i]);
+  return bench_now() - start;
+}
+
+// Inserts are timed, and the list is restored (untimed) by removing them
+static double run_insert(void *arg)
+{
+  ops_ctx *ctx = arg;
+  double elapsed = 0;
+  for (int r = 0; r < ctx->rounds; r++)
+  {
+    double start = bench_now();
+    for (int i = 0; i < ctx->count; i++)
+      list_insert(ctx->list, ctx->value, ctx->indices[i]);
+    elapsed += bench_now() - start;
+    for (int i = 0; i < ctx->count; i++)
+      list_remove(ctx->list, ctx->indices[i]);
+  }
+  return elapsed;
+}
+
+// Removes are timed, after making room for them (untimed) with inserts
+static double run_remove(void *arg)
+{
+  ops_ctx *ctx = arg;
+  double elapsed = 0;
+  for (int r = 0; r < ctx->rounds; r++)
+  {
+    for (int i = 0; i < ctx->count; i++)
+      list_insert(ctx->list, ctx->value, ctx->indices[i]);
+    double start = bench_now();
+    for (int i = 0; i < ctx->count; i++)
+      list_remove(ctx->list, ctx->indices[i]);
+    elapsed += bench_now() - start;
+  }
+  return elapsed;
+}
+
+static double run_enqueue(void *arg)
+{
+  ops_ctx *ctx = arg;
+  double elapsed = 0;
+  for (int r = 0; r < ctx->rounds; r++)
+  {
+    queue_p queue = queue_create(ctx->element_size);
+    double start = bench_now();
+    for (int i = 0; i < ctx->n; i++)
+      queue_enqueue(queue, ctx->value);
+    elapsed += bench_now() - start;
+    queue_delete(queue);
+  }
+  return elapsed;
+}
+
+static double run_dequeue(void *arg)
+{
+  ops_ctx *ctx = arg;
+  char out[256];
+  double elapsed = 0;
+  for (int r = 0; r < ctx->rounds; r++)
+  {
+    queue_p queue = queue_create(ctx->element_size);
+    for (int i = 0; i < ctx->n; i++)
+      queue_enqueue(queue, ctx->value);
+    double start = bench_now();
+    for (int i = 0; i < ctx->n; i++)
+      queue_dequeue(queue, out);
+    elapsed += bench_now() - start;
+    queue_delete(queue);
+  }
+  bench_sink = out[0];
+  return elapsed;
+}
+
+static void bench_ops_size(size_t element_size, int n)
+{
+  ops_ctx ctx;
+  char name[64];
+  ctx.element_size = element_size;
+  ctx.n = n;
+  ctx.rounds = n < min_ops ? min_ops / n : 1;
+  memset(ctx.value, 0x5a, sizeof(ctx.value));
+
+  // The list for get/set/insert/remove, and the random indices into it
+  ctx.list = NULL;
+  ctx.indices = malloc(num_indices * sizeof(int));
+  for (int i = 0; i < num_indices; i++)
+    ctx.indices[i] = (int)(bench_rand() % n);
+
+  snprintf(name, sizeof(name), "append es=%zu n=%d", element_size, n);
+  bench_run("ops", name, (long)n * ctx.rounds, run_append, &ctx);
+
+  ctx.list = list_create_with_capacity(element_size, n);
+  for (int i = 0; i < n; i++)
+    list_append(ctx.list, ctx.value);
+
+  ctx.count = num_indices;
+  snprintf(name, sizeof(name), "get es=%zu n=%d", element_size, n);
+  bench_run("ops", name, ctx.count, run_get, &ctx);
+  snprintf(name, sizeof(name), "set es=%zu n=%d", element_size, n);
+  bench_run("ops", name, ctx.count, run_set, &ctx);
+
+  // Each insert/remove moves half of the list on average. A batch is
+  // at most n inserts (so the list at most doubles), then n removes
+  long moves = MOVE_BYTES / ((long)n * (long)element_size / 2 + 1);
+  moves = moves < 16 ? 16 : (moves > min_ops ? min_ops : moves);
+  ctx.count = moves < n ? (int)moves : n;
+  ctx.rounds = (int)(moves / ctx.count);
+  snprintf(name, sizeof(name), "insert es=%zu n=%d", element_size, n);
+  bench_run("ops", name, (long)ctx.count * ctx.rounds, run_insert, &ctx);
+  snprintf(name, sizeof(name), "remove es=%zu n=%d", element_size, n);
+  bench_run("ops", name, (long)ctx.count * ctx.rounds, run_remove, &ctx);
+  ctx.rounds = n < min_ops ? min_ops / n : 1;
+  list_delete(ctx.list);
+  free(ctx.indices);
+
+  // Queue elements are separate allocations, so they take more memory
+  if ((long)n * (long)(queue_node_size(element_size) + 16) <= MAX_BYTES)
+  {
+    snprintf(name, sizeof(name), "enqueue es=%zu n=%d", element_size, n);
+    bench_run("ops", name, (long)n * ctx.rounds, run_enqueue, &ctx);
+    snprintf(name, sizeof(name), "dequeue es=%zu n=%d", element_size, n);
+    bench_run("ops", name, (long)n * ctx.rounds, run_dequeue, &ctx);
+  }
+}
+
+void bench_ops(void)
+{
+  min_ops = (int)bench_size(MIN_OPS);
+  num_indices = (int)bench_size(NUM_INDICES);
+  for (int s = 0; s < NUM_SIZES; s++)
+  {
+    if (sizes[s] > bench_max_size())
+      break;
+    for (int e = 0; e < NUM_ELEMENT_SIZES; e++)
+    {
+      if (sizes[s] * (long)element_sizes[e] <= MAX_BYTES)
+        bench_ops_size(element_sizes[e], (int)sizes[s]);
+    }
+  }
+}
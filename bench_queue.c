@@ -0,0 +1,378 @@
+/**
+ * Benchmarks for the linked queue, intrusive queue and ring queue modules
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include "bench.h"
+#include "queue.h"
+#include "allocator.h"
+#include "intrusive_queue.h"
+#include "ring_queue.h"
+
+// Number of operations per benchmark (at most --max-size)
+#define NUM_OPS (1 << 20)
+static int num_ops;
+
+// Number of items kept in the queue for the steady state benchmarks
+#define STEADY_LENGTH 64
+
+static void bench_linked_fill_drain(void)
+{
+  queue_p queue = queue_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    queue_enqueue(queue, &i);
+  for (int i = 0; i < num_ops; i++)
+  {
+    queue_dequeue(queue, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("queue", "linked enqueue+dequeue (fill/drain)", 2L * num_ops, elapsed);
+  queue_delete(queue);
+}
+
+static void bench_ring_fill_drain(void)
+{
+  ring_queue_p queue = ring_queue_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+    ring_queue_enqueue(queue, &i);
+  for (int i = 0; i < num_ops; i++)
+  {
+    ring_queue_dequeue(queue, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("queue", "ring enqueue+dequeue (fill/drain)", 2L * num_ops, elapsed);
+  ring_queue_delete(queue);
+}
+
+static void bench_linked_steady(void)
+{
+  queue_p queue = queue_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+
+  for (int i = 0; i < STEADY_LENGTH; i++)
+    queue_enqueue(queue, &i);
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    queue_enqueue(queue, &i);
+    queue_dequeue(queue, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("queue", "linked enqueue+dequeue (steady state)", 2L * num_ops, elapsed);
+  queue_delete(queue);
+}
+
+static void bench_ring_steady(void)
+{
+  ring_queue_p queue = ring_queue_create(sizeof(int));
+  int value = 0;
+  long sum = 0;
+
+  for (int i = 0; i < STEADY_LENGTH; i++)
+    ring_queue_enqueue(queue, &i);
+
+  double start = bench_now();
+  for (int i = 0; i < num_ops; i++)
+  {
+    ring_queue_enqueue(queue, &i);
+    ring_queue_dequeue(queue, &value);
+    sum += value;
+  }
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("queue", "ring enqueue+dequeue (steady state)", 2L * num_ops, elapsed);
+  ring_queue_delete(queue);
+}
+
+/*
+An allocator which counts the allocations made through it, the bytes
+requested and the bytes of heap they take up (the usable size plus the
+malloc chunk header), so that the layouts can be compared by the memory
+they use. RSS growth would instead depend on what earlier benchmarks
+left in the heap
+*/
+struct counting
+{
+  long allocs;
+  long bytes;
+  long heap_bytes;
+};
+
+static void *counting_alloc(void *ctx, size_t size)
+{
+  struct counting *counting = ctx;
+  void *ptr = malloc(size);
+  counting->allocs++;
+  counting->bytes += size;
+  counting->heap_bytes += malloc_usable_size(ptr) + sizeof(size_t);
+  return ptr;
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+  struct counting *counting = ctx;
+  counting->heap_bytes -= ptr ? malloc_usable_size(ptr) + sizeof(size_t) : 0;
+  ptr = realloc(ptr, new_size);
+  counting->allocs++;
+  counting->bytes += new_size - old_size;
+  counting->heap_bytes += malloc_usable_size(ptr) + sizeof(size_t);
+  return ptr;
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size)
+{
+  (void)ctx;
+  (void)size;
+  free(ptr);
+}
+
+/*
+A replica of the original queue element layout, where the data is a
+separate allocation, kept to compare against the inline and intrusive layouts
+*/
+struct legacy_element
+{
+  char *data;
+  struct legacy_element *next;
+};
+
+struct legacy_queue
+{
+  struct legacy_element *head;
+  struct legacy_element *tail;
+  size_t element_size;
+  allocator alloc;
+};
+
+static void legacy_enqueue(struct legacy_queue *queue, void *value)
+{
+  struct legacy_element *element = queue->alloc.alloc(queue->alloc.ctx, sizeof(struct legacy_element));
+  element->data = queue->alloc.alloc(queue->alloc.ctx, queue->element_size);
+  element->next = NULL;
+  memcpy(element->data, value, queue->element_size);
+  if (queue->head == NULL)
+    queue->head = element;
+  else
+    queue->tail->next = element;
+  queue->tail = element;
+}
+
+static void legacy_dequeue(struct legacy_queue *queue, void *out)
+{
+  struct legacy_element *element = queue->head;
+  memcpy(out, element->data, queue->element_size);
+  queue->head = element->next;
+  queue->alloc.free(queue->alloc.ctx, element->data, queue->element_size);
+  queue->alloc.free(queue->alloc.ctx, element, sizeof(struct legacy_element));
+}
+
+// An item for the intrusive queue, owned by the caller
+struct item
+{
+  int value;
+  queue_link link;
+};
+
+enum layout
+{
+  LAYOUT_LEGACY,
+  LAYOUT_INLINE,
+  LAYOUT_INTRUSIVE
+};
+
+static const char *layout_names[] = {
+    "legacy (2 allocs/element)",
+    "inline data (1 alloc/element)",
+    "intrusive (no allocs)"};
+
+/*
+Fills a queue with num_ops ints in the given layout, then drains it.
+Reports the latency of each phase, and the allocations, bytes requested
+and bytes of heap per item to fill the queue (the items of the intrusive queue
+are allocated by the caller, as one array, through the same allocator)
+*/
+static void bench_layout(enum layout layout)
+{
+  struct counting counting = {0, 0, 0};
+  allocator alloc = {counting_alloc, counting_realloc, counting_free, &counting};
+  struct legacy_queue legacy = {NULL, NULL, sizeof(int), alloc};
+  queue_p queue = queue_create_ex(sizeof(int), &alloc);
+  intrusive_queue intrusive;
+  intrusive_queue_init(&intrusive);
+  struct item *items = NULL;
+  char name[96];
+  int value = 0;
+  long sum = 0;
+
+  // Leave out the allocation of the queue itself
+  counting.allocs = 0;
+  counting.bytes = 0;
+  counting.heap_bytes = 0;
+  double start = bench_now();
+  switch (layout)
+  {
+  case LAYOUT_LEGACY:
+    for (int i = 0; i < num_ops; i++)
+      legacy_enqueue(&legacy, &i);
+    break;
+  case LAYOUT_INLINE:
+    for (int i = 0; i < num_ops; i++)
+      queue_enqueue(queue, &i);
+    break;
+  case LAYOUT_INTRUSIVE:
+    // The caller provides the storage for its items
+    items = alloc.alloc(alloc.ctx, num_ops * sizeof(struct item));
+    for (int i = 0; i < num_ops; i++)
+    {
+      items[i].value = i;
+      intrusive_queue_enqueue(&intrusive, &items[i].link);
+    }
+    break;
+  }
+  double elapsed = bench_now() - start;
+  struct counting filled = counting;
+
+  snprintf(name, sizeof(name), "enqueue, %s", layout_names[layout]);
+  bench_report("queue", name, num_ops, elapsed);
+
+  start = bench_now();
+  switch (layout)
+  {
+  case LAYOUT_LEGACY:
+    for (int i = 0; i < num_ops; i++)
+    {
+      legacy_dequeue(&legacy, &value);
+      sum += value;
+    }
+    break;
+  case LAYOUT_INLINE:
+    for (int i = 0; i < num_ops; i++)
+    {
+      queue_dequeue(queue, &value);
+      sum += value;
+    }
+    break;
+  case LAYOUT_INTRUSIVE:
+    for (int i = 0; i < num_ops; i++)
+      sum += queue_entry(intrusive_queue_dequeue(&intrusive), struct item, link)->value;
+    break;
+  }
+  elapsed = bench_now() - start;
+  bench_sink = sum;
+
+  snprintf(name, sizeof(name), "dequeue, %s", layout_names[layout]);
+  bench_report("queue", name, num_ops, elapsed);
+  // Memory use is not a time per operation, so it goes to stderr
+  // (keeping the csv and json output on stdout valid)
+  snprintf(name, sizeof(name), "memory, %s", layout_names[layout]);
+  if (bench_selected(name))
+    fprintf(stderr, "%-14s %-40s %12d items %6.3f allocs/item %6.1f bytes/item %6.1f heap bytes/item\n",
+            "queue", name, num_ops,
+            (double)filled.allocs / num_ops, (double)filled.bytes / num_ops,
+            (double)filled.heap_bytes / num_ops);
+
+  if (items)
+    alloc.free(alloc.ctx, items, num_ops * sizeof(struct item));
+  queue_delete(queue);
+}
+
+static void bench_layouts(void)
+{
+  for (enum layout layout = LAYOUT_LEGACY; layout <= LAYOUT_INTRUSIVE; layout++)
+    bench_layout(layout);
+}
+
+static void drain_sum(const void *value, void *ctx)
+{
+  *(long *)ctx += *(const int *)value;
+}
+
+/*
+Moves num_ops items through the queue in batches of batch items:
+one call per item, enqueue_n/dequeue_n, and enqueue_n/drain
+*/
+static void bench_batch(int batch)
+{
+  queue_p queue = queue_create(sizeof(int));
+  int *values = malloc(batch * sizeof(int));
+  int got = 0;
+  long sum = 0;
+  char name[64];
+  for (int i = 0; i < batch; i++)
+    values[i] = i;
+
+  double start = bench_now();
+  for (int n = 0; n < num_ops; n += batch)
+  {
+    for (int i = 0; i < batch; i++)
+      queue_enqueue(queue, &values[i]);
+    for (int i = 0; i < batch; i++)
+      queue_dequeue(queue, &values[i]);
+    sum += values[0];
+  }
+  double elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "enqueue+dequeue, batch %d", batch);
+  bench_report("queue", name, 2L * num_ops, elapsed);
+
+  start = bench_now();
+  for (int n = 0; n < num_ops; n += batch)
+  {
+    queue_enqueue_n(queue, values, batch);
+    queue_dequeue_n(queue, values, batch, &got);
+    sum += values[0];
+  }
+  elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "enqueue_n+dequeue_n, batch %d", batch);
+  bench_report("queue", name, 2L * num_ops, elapsed);
+
+  start = bench_now();
+  for (int n = 0; n < num_ops; n += batch)
+  {
+    queue_enqueue_n(queue, values, batch);
+    queue_drain(queue, drain_sum, &sum);
+  }
+  elapsed = bench_now() - start;
+  snprintf(name, sizeof(name), "enqueue_n+drain, batch %d", batch);
+  bench_report("queue", name, 2L * num_ops, elapsed);
+
+  bench_sink = sum;
+  free(values);
+  queue_delete(queue);
+}
+
+void bench_queue(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  bench_linked_fill_drain();
+  bench_ring_fill_drain();
+  bench_linked_steady();
+  bench_ring_steady();
+  bench_layouts();
+  bench_batch(1);
+  bench_batch(16);
+  bench_batch(256);
+}
@@ -0,0 +1,112 @@
+/**
+ * Scaling benchmark for the scheduler module: a fork/join parallel sum
+ * over a large list, from one worker up to one per core
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "bench.h"
+#include "array_list.h"
+#include "scheduler.h"
+
+// Number of elements in the list
+#define LIST_SIZE (1 << 24)
+static int num_items;
+
+// Ranges of at most this many elements are summed without splitting
+#define GRAIN 16384
+
+// Number of times each sum is repeated
+#define REPEATS 5
+
+static scheduler_p sched;
+
+struct sum_args
+{
+  const int64_t *data;
+  int from;
+  int to;
+  int64_t result;
+};
+
+static int64_t sum_serial(const int64_t *data, int from, int to)
+{
+  int64_t sum = 0;
+  for (int i = from; i < to; i++)
+    sum += data[i];
+  return sum;
+}
+
+// Spawn the left half, sum the right half, then wait for the left
+static void sum_task(void *arg)
+{
+  struct sum_args *args = arg;
+  if (args->to - args->from <= GRAIN)
+  {
+    args->result = sum_serial(args->data, args->from, args->to);
+    return;
+  }
+
+  int middle = args->from + (args->to - args->from) / 2;
+  struct sum_args left = {args->data, args->from, middle, 0};
+  struct sum_args right = {args->data, middle, args->to, 0};
+  task_group group;
+  task_group_init(&group);
+  scheduler_spawn(sched, &group, sum_task, &left);
+  sum_task(&right);
+  scheduler_wait(sched, &group);
+  args->result = left.result + right.result;
+}
+
+void bench_scheduler(void)
+{
+  num_items = (int)bench_size(LIST_SIZE);
+  list_p list = list_create_with_capacity(sizeof(int64_t), num_items);
+  for (int64_t i = 0; i < num_items; i++)
+    list_append(list, &i);
+
+  const void *data;
+  int length;
+  list_data_span(list, &data, &length);
+  int64_t expected = (int64_t)num_items * (num_items - 1) / 2;
+  char name[64];
+
+  double start = bench_now();
+  for (int r = 0; r < REPEATS; r++)
+    bench_sink = sum_serial(data, 0, length);
+  double elapsed = bench_now() - start;
+  bench_report("scheduler", "sum, serial loop", (long)REPEATS * length, elapsed);
+
+  int max_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  for (int workers = 1;; workers *= 2)
+  {
+    if (workers > max_workers)
+      workers = max_workers;
+
+    sched = scheduler_create(workers);
+    start = bench_now();
+    for (int r = 0; r < REPEATS; r++)
+    {
+      struct sum_args args = {data, 0, length, 0};
+      task_group group;
+      task_group_init(&group);
+      scheduler_spawn(sched, &group, sum_task, &args);
+      scheduler_wait(sched, &group);
+      if (args.result != expected)
+        fprintf(stderr, "scheduler: incorrect sum %lld\n", (long long)args.result);
+      bench_sink = args.result;
+    }
+    elapsed = bench_now() - start;
+    scheduler_delete(sched);
+
+    snprintf(name, sizeof(name), "sum, fork/join on %d workers", workers);
+    bench_report("scheduler", name, (long)REPEATS * length, elapsed);
+
+    if (workers == max_workers)
+      break;
+  }
+
+  list_delete(list);
+}
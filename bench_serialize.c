@@ -0,0 +1,106 @@
+/**
+ * Save and load benchmarks for lists and queues: list_save/list_load
+ * (which maps the file instead of copying the items) against reading
+ * the items back with fread and re-appending them, as checkpoints did
+ * before, and queue_save/queue_load
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+#include "array_list.h"
+#include "queue.h"
+
+#define BENCH_PATH "/tmp/bench_serialize.dsd"
+
+// 100M ints for the list (400MB); queue elements are 32 bytes each, so fewer
+#define LIST_ITEMS 100000000
+static int list_items;
+#define QUEUE_ITEMS 10000000
+static int queue_items;
+
+// Items per fread for the re-append baseline
+#define READ_BATCH 4096
+
+/*
+Name of a benchmark with its number of items, e.g. "list_load 100000000 ints"
+(in a static buffer, which is overwritten by the next call)
+*/
+static const char *sized_name(const char *name, int count)
+{
+  static char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%s %d ints", name, count);
+  return buffer;
+}
+
+static void bench_list_io(void)
+{
+  list_p list = list_create_with_capacity(sizeof(int), list_items);
+  for (int i = 0; i < list_items; i++)
+    list_append(list, &i);
+
+  double start = bench_now();
+  list_save(list, BENCH_PATH);
+  bench_report("serialize", sized_name("list_save", list_items), list_items, bench_now() - start);
+  list_delete(list);
+
+  // Baseline: read the items and append each one
+  start = bench_now();
+  FILE *file = fopen(BENCH_PATH, "rb");
+  fseek(file, 64, SEEK_SET); // skip the header
+  list = list_create(sizeof(int));
+  int buffer[READ_BATCH];
+  size_t got;
+  while ((got = fread(buffer, sizeof(int), READ_BATCH, file)) > 0)
+  {
+    for (size_t i = 0; i < got; i++)
+      list_append(list, &buffer[i]);
+  }
+  fclose(file);
+  double elapsed = bench_now() - start;
+  bench_sink = list_size(list);
+  list_delete(list);
+  bench_report("serialize", sized_name("fread + list_append", list_items), list_items, elapsed);
+
+  start = bench_now();
+  list = list_load(BENCH_PATH, sizeof(int));
+  elapsed = bench_now() - start;
+  bench_report("serialize", sized_name("list_load", list_items), list_items, elapsed);
+
+  long sum = 0;
+  for (int i = 0; i < list_size(list); i++)
+    sum += *(const int *)list_at(list, i);
+  bench_sink = sum;
+  bench_report("serialize", sized_name("list_load + scan", list_items), list_items, bench_now() - start);
+  list_delete(list);
+  unlink(BENCH_PATH);
+}
+
+static void bench_queue_io(void)
+{
+  queue_p queue = queue_create(sizeof(int));
+  for (int i = 0; i < queue_items; i++)
+    queue_enqueue(queue, &i);
+
+  double start = bench_now();
+  queue_save(queue, BENCH_PATH);
+  bench_report("serialize", sized_name("queue_save", queue_items), queue_items, bench_now() - start);
+  queue_delete(queue);
+
+  start = bench_now();
+  queue = queue_load(BENCH_PATH, sizeof(int));
+  bench_report("serialize", sized_name("queue_load", queue_items), queue_items, bench_now() - start);
+  bench_sink = queue_size(queue);
+  queue_delete(queue);
+  unlink(BENCH_PATH);
+}
+
+void bench_serialize(void)
+{
+  list_items = (int)bench_size(LIST_ITEMS);
+  queue_items = (int)bench_size(QUEUE_ITEMS);
+  bench_list_io();
+  bench_queue_io();
+}
@@ -0,0 +1,176 @@
+/**
+ * Two-thread benchmarks for the spsc queue module,
+ * compared against the linked queue protected by a mutex
+ *
+ */
+
+#include <stdio.h>
+#include <sched.h>
+#include <pthread.h>
+#include "bench.h"
+#include "queue.h"
+#include "spsc_queue.h"
+
+// Number of items passed from the producer to the consumer
+#define NUM_OPS (1 << 22)
+static int num_ops;
+
+// Number of round trips in the latency benchmark
+#define NUM_ROUND_TRIPS (1 << 16)
+static int num_round_trips;
+
+#define CAPACITY 1024
+
+/*
+The linked queue guarded by a mutex (the status quo for cross-thread handoff)
+*/
+struct locked_queue
+{
+  queue_p queue;
+  int length;
+  pthread_mutex_t lock;
+};
+
+static void *spsc_producer(void *arg)
+{
+  spsc_queue_p queue = arg;
+  for (int i = 0; i < num_ops; i++)
+  {
+    while (!spsc_queue_enqueue(queue, &i))
+      sched_yield();
+  }
+  return NULL;
+}
+
+static void *locked_producer(void *arg)
+{
+  struct locked_queue *locked = arg;
+  for (int i = 0; i < num_ops; i++)
+  {
+    pthread_mutex_lock(&locked->lock);
+    queue_enqueue(locked->queue, &i);
+    locked->length++;
+    pthread_mutex_unlock(&locked->lock);
+  }
+  return NULL;
+}
+
+static void bench_spsc_throughput(void)
+{
+  spsc_queue_p queue = spsc_queue_create(sizeof(int), CAPACITY);
+  pthread_t thread;
+  int value;
+  long sum = 0;
+
+  double start = bench_now();
+  pthread_create(&thread, NULL, spsc_producer, queue);
+  for (int i = 0; i < num_ops; i++)
+  {
+    while (!spsc_queue_dequeue(queue, &value))
+      sched_yield();
+    sum += value;
+  }
+  pthread_join(thread, NULL);
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("spsc_queue", "spsc throughput (2 threads)", num_ops, elapsed);
+  spsc_queue_delete(queue);
+}
+
+static void bench_locked_throughput(void)
+{
+  struct locked_queue locked;
+  locked.queue = queue_create(sizeof(int));
+  locked.length = 0;
+  pthread_mutex_init(&locked.lock, NULL);
+  pthread_t thread;
+  int value;
+  long sum = 0;
+
+  double start = bench_now();
+  pthread_create(&thread, NULL, locked_producer, &locked);
+  for (int i = 0; i < num_ops; i++)
+  {
+    bool got = false;
+    while (!got)
+    {
+      pthread_mutex_lock(&locked.lock);
+      if (locked.length > 0)
+      {
+        queue_dequeue(locked.queue, &value);
+        locked.length--;
+        got = true;
+      }
+      pthread_mutex_unlock(&locked.lock);
+      if (!got)
+        sched_yield();
+    }
+    sum += value;
+  }
+  pthread_join(thread, NULL);
+  double elapsed = bench_now() - start;
+
+  bench_sink = sum;
+  bench_report("spsc_queue", "mutex+linked queue throughput (2 threads)", num_ops, elapsed);
+  pthread_mutex_destroy(&locked.lock);
+  queue_delete(locked.queue);
+}
+
+/*
+Queues for the ping-pong latency benchmark
+*/
+struct ping_pong
+{
+  spsc_queue_p ping;
+  spsc_queue_p pong;
+};
+
+static void *pong_thread(void *arg)
+{
+  struct ping_pong *queues = arg;
+  int value;
+  for (int i = 0; i < num_round_trips; i++)
+  {
+    while (!spsc_queue_dequeue(queues->ping, &value))
+      sched_yield();
+    while (!spsc_queue_enqueue(queues->pong, &value))
+      sched_yield();
+  }
+  return NULL;
+}
+
+static void bench_spsc_latency(void)
+{
+  struct ping_pong queues;
+  queues.ping = spsc_queue_create(sizeof(int), CAPACITY);
+  queues.pong = spsc_queue_create(sizeof(int), CAPACITY);
+  pthread_t thread;
+  int value;
+
+  pthread_create(&thread, NULL, pong_thread, &queues);
+  double start = bench_now();
+  for (int i = 0; i < num_round_trips; i++)
+  {
+    while (!spsc_queue_enqueue(queues.ping, &i))
+      sched_yield();
+    while (!spsc_queue_dequeue(queues.pong, &value))
+      sched_yield();
+  }
+  double elapsed = bench_now() - start;
+  pthread_join(thread, NULL);
+
+  // Each round trip is two one-way handoffs
+  bench_report("spsc_queue", "spsc one-way latency (ping-pong)", 2L * num_round_trips, elapsed);
+  spsc_queue_delete(queues.ping);
+  spsc_queue_delete(queues.pong);
+}
+
+void bench_spsc_queue(void)
+{
+  num_ops = (int)bench_size(NUM_OPS);
+  num_round_trips = (int)bench_size(NUM_ROUND_TRIPS);
+  bench_spsc_throughput();
+  bench_locked_throughput();
+  bench_spsc_latency();
+}
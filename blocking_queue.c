@@ -0,0 +1,286 @@
+/**
+ * blocking_queue.c
+ *
+ * Implementation of functions for the blocking_queue module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include "blocking_queue_p.h"
+#include "queue.h"
+
+/*
+The blocking queue wraps a queue_p with a mutex and two condition variables.
+Consumers wait on not_empty, producers wait on not_full (only when there
+is a capacity). The waiting counts let push/pop skip the signal when
+nobody is waiting.
+The condition variables use CLOCK_MONOTONIC so that timeouts are not
+affected by changes to the system time
+*/
+typedef struct blocking_queue
+{
+  queue_p queue;
+  int capacity; // 0 for no limit
+  bool closed;
+  int waiting_consumers;
+  int waiting_producers;
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+} *blocking_queue_p;
+
+/*
+Creates and initialises a new empty blocking queue
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the queue
+  capacity - the maximum number of items in the queue (0 for no limit)
+
+Returns:
+  A blocking_queue_p (pointer to the newly created queue)
+
+Throws:
+  aborts if capacity is negative or if the memory allocations fail
+
+*/
+blocking_queue_p blocking_queue_create(size_t element_size, int capacity)
+{
+  assert(capacity >= 0 && "Error: Capacity must not be negative");
+
+  blocking_queue_p queue;
+  queue = (blocking_queue_p)malloc(sizeof(struct blocking_queue));
+  assert(queue != NULL && "Error in memory allocation");
+
+  queue->queue = queue_create(element_size);
+  queue->capacity = capacity;
+  queue->closed = false;
+  queue->waiting_consumers = 0;
+  queue->waiting_producers = 0;
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_mutex_init(&queue->lock, NULL);
+  pthread_cond_init(&queue->not_empty, &attr);
+  pthread_cond_init(&queue->not_full, &attr);
+  pthread_condattr_destroy(&attr);
+
+  return queue;
+}
+
+/*
+Enqueue an item at the back/tail of the queue, waiting while it is full
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+  value - pointer to a variable containing the value of the item to be enqueued
+
+Returns:
+  BLOCKING_QUEUE_OK if the item was enqueued
+  BLOCKING_QUEUE_CLOSED if the queue is closed
+
+*/
+blocking_queue_status blocking_queue_push(blocking_queue_p queue, void *value)
+{
+  pthread_mutex_lock(&queue->lock);
+  while (!queue->closed && _is_blocking_queue_full(queue))
+  {
+    queue->waiting_producers++;
+    pthread_cond_wait(&queue->not_full, &queue->lock);
+    queue->waiting_producers--;
+  }
+
+  if (queue->closed)
+  {
+    pthread_mutex_unlock(&queue->lock);
+    return BLOCKING_QUEUE_CLOSED;
+  }
+
+  queue_enqueue(queue->queue, value);
+  if (queue->waiting_consumers > 0)
+    pthread_cond_signal(&queue->not_empty);
+  pthread_mutex_unlock(&queue->lock);
+  return BLOCKING_QUEUE_OK;
+}
+
+/*
+Dequeue the item at the head of the queue, waiting while it is empty
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+  out - pointer to a variable to store the value of the dequeued item
+
+Outputs:
+  out - the value of the dequeued item (unchanged unless OK is returned)
+
+Returns:
+  BLOCKING_QUEUE_OK if an item was dequeued
+  BLOCKING_QUEUE_CLOSED if the queue is closed and empty
+
+*/
+blocking_queue_status blocking_queue_pop(blocking_queue_p queue, void *out)
+{
+  return blocking_queue_pop_timed(queue, out, -1);
+}
+
+/*
+Dequeue the item at the head of the queue, waiting at most timeout_ms
+while it is empty
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+  out - pointer to a variable to store the value of the dequeued item
+  timeout_ms - the maximum time to wait in milliseconds
+               (negative waits without a time limit)
+
+Outputs:
+  out - the value of the dequeued item (unchanged unless OK is returned)
+
+Returns:
+  BLOCKING_QUEUE_OK if an item was dequeued
+  BLOCKING_QUEUE_TIMEOUT if the queue was still empty after timeout_ms
+  BLOCKING_QUEUE_CLOSED if the queue is closed and empty
+
+*/
+blocking_queue_status blocking_queue_pop_timed(blocking_queue_p queue, void *out, long timeout_ms)
+{
+  struct timespec deadline;
+  if (timeout_ms > 0)
+    deadline = _deadline_after(timeout_ms);
+
+  pthread_mutex_lock(&queue->lock);
+  while (!queue->closed && queue_size(queue->queue) == 0)
+  {
+    if (timeout_ms == 0)
+      break;
+
+    int result = 0;
+    queue->waiting_consumers++;
+    if (timeout_ms < 0)
+      pthread_cond_wait(&queue->not_empty, &queue->lock);
+    else
+      result = pthread_cond_timedwait(&queue->not_empty, &queue->lock, &deadline);
+    queue->waiting_consumers--;
+
+    if (result == ETIMEDOUT)
+      break;
+  }
+
+  // Items left in a closed queue are still handed out
+  if (queue_size(queue->queue) == 0)
+  {
+    bool closed = queue->closed;
+    pthread_mutex_unlock(&queue->lock);
+    return closed ? BLOCKING_QUEUE_CLOSED : BLOCKING_QUEUE_TIMEOUT;
+  }
+
+  queue_dequeue(queue->queue, out);
+  if (queue->waiting_producers > 0)
+    pthread_cond_signal(&queue->not_full);
+  pthread_mutex_unlock(&queue->lock);
+  return BLOCKING_QUEUE_OK;
+}
+
+/*
+Closes the queue and wakes all waiting threads
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+
+Returns:
+  Nothing
+
+*/
+void blocking_queue_close(blocking_queue_p queue)
+{
+  pthread_mutex_lock(&queue->lock);
+  queue->closed = true;
+  pthread_cond_broadcast(&queue->not_empty);
+  pthread_cond_broadcast(&queue->not_full);
+  pthread_mutex_unlock(&queue->lock);
+}
+
+/*
+Get the number of items currently in the queue
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int blocking_queue_size(blocking_queue_p queue)
+{
+  pthread_mutex_lock(&queue->lock);
+  int size = queue_size(queue->queue);
+  pthread_mutex_unlock(&queue->lock);
+  return size;
+}
+
+/*
+Frees the memory allocated to queue
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+
+Returns:
+  Nothing
+
+*/
+void blocking_queue_delete(blocking_queue_p queue)
+{
+  if (queue)
+  {
+    queue_delete(queue->queue);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+  }
+}
+
+/*
+Internal function to check if the queue is at its capacity
+(called with the lock held)
+
+Inputs:
+  queue - pointer to an instance of the blocking queue type
+
+Returns:
+  True if the queue has a capacity and is full
+  False otherwise
+
+*/
+bool _is_blocking_queue_full(blocking_queue_p queue)
+{
+  return queue->capacity > 0 && queue_size(queue->queue) >= queue->capacity;
+}
+
+/*
+Internal function to get the CLOCK_MONOTONIC time timeout_ms from now
+
+Inputs:
+  timeout_ms - the time from now in milliseconds
+
+Returns:
+  The deadline
+
+*/
+struct timespec _deadline_after(long timeout_ms)
+{
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += timeout_ms / 1000;
+  deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return deadline;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file blocking_queue.h
+ * @brief Public function prototypes for the blocking_queue module
+ *
+ * Function prototypes required to use the blocking_queue module.
+ * The blocking queue is a thread-safe queue (a queue_p protected by a
+ * mutex) which consumers can sleep on until an item arrives, rather
+ * than polling. An optional capacity makes producers wait while the
+ * queue is full (backpressure).
+ *
+ * Closing the queue wakes every waiting thread: pushes then fail, and
+ * pops return the remaining items before failing.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+
+#ifndef BLOCKING_QUEUE
+#define BLOCKING_QUEUE
+
+/**
+ * @brief Data type represeting the blocking queue
+ */
+typedef struct blocking_queue *blocking_queue_p;
+
+/**
+ * @brief Return codes for the blocking queue operations
+ */
+typedef enum blocking_queue_status
+{
+  BLOCKING_QUEUE_OK = 0,   // the operation succeeded
+  BLOCKING_QUEUE_TIMEOUT,  // pop timed out with the queue still empty
+  BLOCKING_QUEUE_CLOSED    // the queue is closed (and, for pop, empty)
+} blocking_queue_status;
+
+/**
+ * @brief create and initialise a new blocking queue
+ *
+ * The initial size of the queue is zero.
+ * Example usage to create a queue of up to 1024 ints:
+ * blocking_queue_p my_queue;
+ * my_queue = blocking_queue_create(sizeof(int), 1024);
+ *
+ * @param[in] element_size The size of the data type to be stored in the queue
+ * @param[in] capacity The maximum number of items in the queue (0 for no limit)
+ * @return A blocking_queue_p (i.e. pointer to the queue data type) to the created queue
+ */
+blocking_queue_p blocking_queue_create(size_t element_size, int capacity);
+
+/**
+ * @brief add a new value to the back/tail of the queue
+ *
+ * Waits while the queue is full.
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @param[in] value pointer to a variable storing the value to be added to the queue
+ * @return BLOCKING_QUEUE_OK if the value was added, BLOCKING_QUEUE_CLOSED
+ *         if the queue is (or was while waiting) closed
+ */
+blocking_queue_status blocking_queue_push(blocking_queue_p queue, void *value);
+
+/**
+ * @brief Remove the item at the top/head of the queue
+ *
+ * Waits while the queue is empty.
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ * @return BLOCKING_QUEUE_OK if an item was removed, BLOCKING_QUEUE_CLOSED
+ *         if the queue is closed and empty (out is unchanged)
+ */
+blocking_queue_status blocking_queue_pop(blocking_queue_p queue, void *out);
+
+/**
+ * @brief Remove the item at the top/head of the queue, waiting at most timeout_ms
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ * @param[in] timeout_ms The maximum time to wait, in milliseconds
+ *                       (0 does not wait, negative waits without a limit)
+ * @return BLOCKING_QUEUE_OK if an item was removed, BLOCKING_QUEUE_TIMEOUT if
+ *         the queue was still empty after timeout_ms, BLOCKING_QUEUE_CLOSED if
+ *         the queue is closed and empty (out is unchanged unless OK)
+ */
+blocking_queue_status blocking_queue_pop_timed(blocking_queue_p queue, void *out, long timeout_ms);
+
+/**
+ * @brief Close the queue and wake all waiting threads
+ *
+ * Closing an already closed queue has no effect.
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @return nothing
+ */
+void blocking_queue_close(blocking_queue_p queue);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @return The number of items in the queue
+ */
+int blocking_queue_size(blocking_queue_p queue);
+
+/**
+ * @brief Delete the queue and deallocate memory
+ *
+ * No thread may be using the queue (close it and join the threads first).
+ *
+ * @param[in] queue A pointer to an instance of the blocking_queue_p data type
+ * @return nothing
+ */
+void blocking_queue_delete(blocking_queue_p queue);
+
+#endif
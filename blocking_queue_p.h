@@ -0,0 +1,20 @@
+/**
+ * blocking_queue_p.h
+ *
+ * Private header file for blocking_queue module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdbool.h>
+#include <time.h>
+#include "blocking_queue.h"
+
+#ifndef BLOCKING_QUEUE_P
+#define BLOCKING_QUEUE_P
+
+bool _is_blocking_queue_full(blocking_queue_p queue);
+struct timespec _deadline_after(long timeout_ms);
+
+#endif
@@ -0,0 +1,347 @@
+/**
+ * deque.c
+ *
+ * Implementation of functions for the deque module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "deque_p.h"
+
+// The initial capacity of the buffer
+// Must be a power of two (see _deque_slot)
+#define INITIAL_CAPACITY 16
+
+// As for the array list, the buffer doubles when full, and halves when
+// it is a quarter full (the gap between the two stops a deque which
+// keeps crossing one size from resizing on every push and pop)
+#define CAPACITY_GROW_FACTOR 2
+#define CAPACITY_SHRINK_THRESHOLD 4
+
+/*
+The deque stores elements in a single circular buffer.
+head is the buffer position of index 0 and the elements occupy
+size consecutive positions (modulo capacity) from there.
+Data is a char because pointer arithmetic is used
+*/
+typedef struct deque
+{
+  char *data;
+  int head;     // buffer position of the front of the deque
+  int size;     // number of elements in the deque
+  int capacity; // number of element slots in data (a power of two)
+  size_t element_size;
+} *deque_p;
+
+/*
+Creates and initialises a new empty deque using the deque_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the deque
+
+Returns:
+  A deque_p (pointer to the newly created deque)
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+deque_p deque_create(size_t element_size)
+{
+  deque_p deque;
+
+  deque = (deque_p)malloc(sizeof(struct deque));
+  assert(deque != NULL && "Error in memory allocation");
+
+  deque->head = 0;
+  deque->size = 0;
+  deque->capacity = INITIAL_CAPACITY;
+  deque->element_size = element_size;
+  deque->data = malloc(deque->capacity * deque->element_size);
+  assert(deque->data != NULL && "Error in memory allocation");
+
+  return deque;
+}
+
+/*
+Push a value at the front of the deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  value - pointer to a variable containing the value to be pushed
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void deque_push_front(deque_p deque, void *value)
+{
+  if (_is_deque_full(deque))
+  {
+    _resize_deque(deque, deque->capacity * CAPACITY_GROW_FACTOR);
+  }
+
+  deque->head = (deque->head - 1) & (deque->capacity - 1);
+  deque->size++;
+  memcpy(_deque_slot(deque, 0), value, deque->element_size);
+}
+
+/*
+Push a value at the back of the deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  value - pointer to a variable containing the value to be pushed
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void deque_push_back(deque_p deque, void *value)
+{
+  if (_is_deque_full(deque))
+  {
+    _resize_deque(deque, deque->capacity * CAPACITY_GROW_FACTOR);
+  }
+
+  memcpy(_deque_slot(deque, deque->size), value, deque->element_size);
+  deque->size++;
+}
+
+/*
+Pop the value at the front of the deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  out - pointer to a variable to store the popped value
+
+Outputs:
+  out - the popped value (unchanged if the deque is empty)
+
+Returns:
+  True if a value was popped
+  False if the deque was empty
+
+*/
+bool deque_pop_front(deque_p deque, void *out)
+{
+  if (deque->size == 0)
+    return false;
+
+  memcpy(out, _deque_slot(deque, 0), deque->element_size);
+  deque->head = (deque->head + 1) & (deque->capacity - 1);
+  deque->size--;
+
+  if (_is_deque_too_empty(deque))
+  {
+    _resize_deque(deque, deque->capacity / CAPACITY_GROW_FACTOR);
+  }
+  return true;
+}
+
+/*
+Pop the value at the back of the deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  out - pointer to a variable to store the popped value
+
+Outputs:
+  out - the popped value (unchanged if the deque is empty)
+
+Returns:
+  True if a value was popped
+  False if the deque was empty
+
+*/
+bool deque_pop_back(deque_p deque, void *out)
+{
+  if (deque->size == 0)
+    return false;
+
+  memcpy(out, _deque_slot(deque, deque->size - 1), deque->element_size);
+  deque->size--;
+
+  if (_is_deque_too_empty(deque))
+  {
+    _resize_deque(deque, deque->capacity / CAPACITY_GROW_FACTOR);
+  }
+  return true;
+}
+
+/*
+Get the value at the specified index
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  index - the index of the value (0 is the front)
+  out - pointer to a variable to store the value
+
+Outputs:
+  out - the value at index
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the index is outside the deque bounds
+
+*/
+void deque_get(deque_p deque, int index, void *out)
+{
+  assert(index >= 0 && index < deque->size && "Error: Index outside deque bounds");
+  memcpy(out, _deque_slot(deque, index), deque->element_size);
+}
+
+/*
+Set the value at the specified index
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  value - pointer to a variable containing the new value
+  index - the index of the value (0 is the front)
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if the index is outside the deque bounds
+
+*/
+void deque_set(deque_p deque, void *value, int index)
+{
+  assert(index >= 0 && index < deque->size && "Error: Index outside deque bounds");
+  memcpy(_deque_slot(deque, index), value, deque->element_size);
+}
+
+/*
+Get the number of values in the deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+
+Returns:
+  The number of values in the deque
+
+*/
+int deque_size(deque_p deque)
+{
+  return deque->size;
+}
+
+/*
+Frees the memory allocated to deque
+
+Inputs:
+  deque - pointer to an instance of the deque type
+
+Returns:
+  Nothing
+
+*/
+void deque_delete(deque_p deque)
+{
+  if (deque)
+  {
+    if (deque->data)
+      free(deque->data);
+    free(deque);
+  }
+}
+
+/*
+Internal function to check if the buffer is full
+
+Inputs:
+  deque - pointer to an instance of the deque type
+
+Returns:
+  True if the buffer is full
+  False otherwise
+
+*/
+bool _is_deque_full(deque_p deque)
+{
+  if (deque->size >= deque->capacity)
+    return true;
+  return false;
+}
+
+/*
+Internal function to check if the buffer should shrink
+(as for _is_list_too_empty in array_list.c)
+
+Inputs:
+  deque - pointer to an instance of the deque type
+
+Returns:
+  True if the deque is at most a quarter full and above the initial capacity
+  False otherwise
+
+*/
+bool _is_deque_too_empty(deque_p deque)
+{
+  if (deque->size <= deque->capacity / CAPACITY_SHRINK_THRESHOLD && deque->capacity > INITIAL_CAPACITY)
+    return true;
+  return false;
+}
+
+/*
+Internal function to move the elements to a new buffer of the given
+capacity. The elements may wrap around the end of the old buffer,
+so they are copied in up to two blocks; in the new buffer they start
+at position 0
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  capacity - the new capacity (a power of two, at least size)
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void _resize_deque(deque_p deque, int capacity)
+{
+  char *data = malloc((size_t)capacity * deque->element_size);
+  assert(data != NULL && "Error in memory allocation");
+
+  int first = deque->capacity - deque->head;
+  if (first > deque->size)
+    first = deque->size;
+  memcpy(data, _deque_slot(deque, 0), (size_t)first * deque->element_size);
+  memcpy(data + (size_t)first * deque->element_size, deque->data,
+         (size_t)(deque->size - first) * deque->element_size);
+
+  free(deque->data);
+  deque->data = data;
+  deque->head = 0;
+  deque->capacity = capacity;
+}
+
+/*
+Internal function to get the buffer slot of an index
+
+Inputs:
+  deque - pointer to an instance of the deque type
+  index - the index (0 is the front)
+
+Returns:
+  A pointer to the slot
+
+*/
+void *_deque_slot(deque_p deque, int index)
+{
+  return deque->data + (size_t)((deque->head + index) & (deque->capacity - 1)) * deque->element_size;
+}
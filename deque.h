@@ -0,0 +1,110 @@
+/**
+ * @file deque.h
+ * @brief Public function prototypes for the deque module
+ *
+ * Function prototypes required to use the deque module.
+ * The deque is a double-ended queue stored in a growable circular
+ * buffer: values can be pushed and popped at both ends in amortised
+ * constant time (unlike list_insert/list_remove at index 0, which shift
+ * every element), and read or written by index.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifndef DEQUE
+#define DEQUE
+
+/**
+ * @brief Data type represeting the deque
+ */
+typedef struct deque *deque_p;
+
+/**
+ * @brief create and initialise a new deque
+ *
+ * The initial size of the deque is zero.
+ * Example usage to create a deque of ints:
+ * deque_p my_deque;
+ * my_deque = deque_create(sizeof(int));
+ *
+ * @param[in] element_size The size of the data type to be stored in the deque
+ * @return A deque_p (i.e. pointer to the deque data type) to the created deque
+ */
+deque_p deque_create(size_t element_size);
+
+/**
+ * @brief add a new value at the front of the deque (it becomes index 0)
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[in] value pointer to a variable storing the value to be added
+ * @return nothing
+ */
+void deque_push_front(deque_p deque, void *value);
+
+/**
+ * @brief add a new value at the back of the deque
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[in] value pointer to a variable storing the value to be added
+ * @return nothing
+ */
+void deque_push_back(deque_p deque, void *value);
+
+/**
+ * @brief Remove the value at the front of the deque
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[inout] out pointer to a variable containing the value that was removed
+ * @return true if a value was removed, false if the deque was empty (out is unchanged)
+ */
+bool deque_pop_front(deque_p deque, void *out);
+
+/**
+ * @brief Remove the value at the back of the deque
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[inout] out pointer to a variable containing the value that was removed
+ * @return true if a value was removed, false if the deque was empty (out is unchanged)
+ */
+bool deque_pop_back(deque_p deque, void *out);
+
+/**
+ * @brief get the value at an index (0 is the front)
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[in] index The index of the value
+ * @param[inout] out pointer to a variable storing the value at index
+ * @return nothing
+ */
+void deque_get(deque_p deque, int index, void *out);
+
+/**
+ * @brief set the value at an index (0 is the front)
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @param[in] value pointer to a variable storing the new value
+ * @param[in] index The index of the value
+ * @return nothing
+ */
+void deque_set(deque_p deque, void *value, int index);
+
+/**
+ * @brief Get the number of values in the deque
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @return The number of values in the deque
+ */
+int deque_size(deque_p deque);
+
+/**
+ * @brief Delete the deque and deallocate memory
+ *
+ * @param[in] deque A pointer to an instance of the deque_p data type
+ * @return nothing
+ */
+void deque_delete(deque_p deque);
+
+#endif
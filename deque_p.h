@@ -0,0 +1,21 @@
+/**
+ * deque_p.h
+ *
+ * Private header file for deque module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdbool.h>
+#include "deque.h"
+
+#ifndef DEQUE_P
+#define DEQUE_P
+
+bool _is_deque_full(deque_p deque);
+bool _is_deque_too_empty(deque_p deque);
+void _resize_deque(deque_p deque, int capacity);
+void *_deque_slot(deque_p deque, int index);
+
+#endif
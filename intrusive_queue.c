@@ -0,0 +1,107 @@
+/**
+ * intrusive_queue.c
+ *
+ * Implementation of functions for the intrusive_queue module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include "intrusive_queue.h"
+
+/*
+Initialises an empty intrusive queue
+
+Inputs:
+  queue - pointer to the queue to initialise
+
+Returns:
+  Nothing
+
+*/
+void intrusive_queue_init(intrusive_queue *queue)
+{
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->length = 0;
+}
+
+/*
+Get the link of the item at the top/head of the queue
+
+Inputs:
+  queue - pointer to an instance of the intrusive queue type
+
+Returns:
+  The link at the head of the queue (NULL if the queue is empty)
+
+*/
+queue_link *intrusive_queue_peek(intrusive_queue *queue)
+{
+  return queue->head;
+}
+
+/*
+Enqueue an item at the back/tail of the queue
+
+Inputs:
+  queue - pointer to an instance of the intrusive queue type
+  link - pointer to the queue_link member of the item to be enqueued
+
+Returns:
+  Nothing
+
+*/
+void intrusive_queue_enqueue(intrusive_queue *queue, queue_link *link)
+{
+  link->next = NULL;
+  if (queue->tail == NULL)
+  {
+    queue->head = link;
+  }
+  else
+  {
+    queue->tail->next = link;
+  }
+  queue->tail = link;
+  queue->length++;
+}
+
+/*
+Dequeue the item at the head of the queue
+
+Inputs:
+  queue - pointer to an instance of the intrusive queue type
+
+Returns:
+  The link of the dequeued item (NULL if the queue is empty)
+
+*/
+queue_link *intrusive_queue_dequeue(intrusive_queue *queue)
+{
+  queue_link *link = queue->head;
+  if (link)
+  {
+    queue->head = link->next;
+    if (queue->head == NULL)
+      queue->tail = NULL;
+    link->next = NULL;
+    queue->length--;
+  }
+  return link;
+}
+
+/*
+Get the number of items currently in the queue
+
+Inputs:
+  queue - pointer to an instance of the intrusive queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int intrusive_queue_size(intrusive_queue *queue)
+{
+  return queue->length;
+}
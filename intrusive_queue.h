@@ -0,0 +1,100 @@
+/**
+ * @file intrusive_queue.h
+ * @brief Public function prototypes for the intrusive_queue module
+ *
+ * An intrusive queue links items that the caller owns. Each item embeds
+ * a queue_link member and the queue chains items through it, so the
+ * queue never allocates memory or copies data. The queue itself can also
+ * be embedded in (or declared on the stack of) the caller.
+ *
+ * Example usage:
+ * struct job { int id; queue_link link; };
+ * intrusive_queue jobs;
+ * intrusive_queue_init(&jobs);
+ * intrusive_queue_enqueue(&jobs, &my_job.link);
+ * struct job *next = queue_entry(intrusive_queue_dequeue(&jobs), struct job, link);
+ *
+ * An item may be in at most one queue per queue_link member, and must
+ * stay valid while it is in the queue.
+ *
+ * @author ruairin
+ */
+
+#include <stddef.h>
+
+#ifndef INTRUSIVE_QUEUE
+#define INTRUSIVE_QUEUE
+
+/**
+ * @brief The link member to embed in items stored in an intrusive queue
+ */
+typedef struct queue_link
+{
+  struct queue_link *next;
+} queue_link;
+
+/**
+ * @brief Data type representing the intrusive queue
+ */
+typedef struct intrusive_queue
+{
+  queue_link *head; // top of the queue
+  queue_link *tail; // back of the queue
+  int length;
+} intrusive_queue;
+
+/**
+ * @brief Get the item containing a queue_link
+ *
+ * @param[in] link A pointer to the queue_link member of the item (not NULL)
+ * @param[in] type The type of the item
+ * @param[in] member The name of the queue_link member in type
+ * @return A pointer to the item
+ */
+#define queue_entry(link, type, member) \
+  ((type *)((char *)(link) - offsetof(type, member)))
+
+/**
+ * @brief initialise an empty intrusive queue
+ *
+ * @param[in] queue A pointer to the queue to initialise
+ * @return nothing
+ */
+void intrusive_queue_init(intrusive_queue *queue);
+
+/**
+ * @brief get the link of the item at the top/head of the queue
+ *
+ * @param[in] queue A pointer to an instance of the intrusive_queue type
+ * @return The link at the head of the queue, or NULL if the queue is empty
+ */
+queue_link *intrusive_queue_peek(intrusive_queue *queue);
+
+/**
+ * @brief add an item to the back/tail of the queue
+ *
+ * No memory is allocated and nothing is copied.
+ *
+ * @param[in] queue A pointer to an instance of the intrusive_queue type
+ * @param[in] link A pointer to the queue_link member of the item
+ * @return nothing
+ */
+void intrusive_queue_enqueue(intrusive_queue *queue, queue_link *link);
+
+/**
+ * @brief Remove the item at the top/head of the queue
+ *
+ * @param[in] queue A pointer to an instance of the intrusive_queue type
+ * @return The link of the removed item, or NULL if the queue is empty
+ */
+queue_link *intrusive_queue_dequeue(intrusive_queue *queue);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * @param[in] queue A pointer to an instance of the intrusive_queue type
+ * @return The number of items in the queue
+ */
+int intrusive_queue_size(intrusive_queue *queue);
+
+#endif
@@ -6,11 +6,45 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include "test_perf_counters.h"
+#include "test_allocator.h"
+#include "test_allocator_pages.h"
 #include "test_array_list.h"
+#include "test_array_list_typed.h"
+#include "test_array_list_simd.h"
+#include "test_array_list_sort.h"
+#include "test_array_list_search.h"
+#include "test_array_list_mapped.h"
+#include "test_array_list_io.h"
 #include "test_queue.h"
+#include "test_intrusive_queue.h"
+#include "test_ring_queue.h"
+#include "test_deque.h"
+#include "test_spsc_queue.h"
+#include "test_mpmc_queue.h"
+#include "test_blocking_queue.h"
+#include "test_ws_deque.h"
+#include "test_scheduler.h"
 
 int main(void)
 {
+  test_perf_counters();
+  test_allocator();
+  test_allocator_pages();
   test_array_list();
+  test_array_list_typed();
+  test_array_list_simd();
+  test_array_list_sort();
+  test_array_list_search();
+  test_array_list_mapped();
+  test_array_list_io();
   test_queue();
+  test_intrusive_queue();
+  test_ring_queue();
+  test_deque();
+  test_spsc_queue();
+  test_mpmc_queue();
+  test_blocking_queue();
+  test_ws_deque();
+  test_scheduler();
 }
@@ -0,0 +1,297 @@
+/**
+ * mpmc_queue.c
+ *
+ * Implementation of functions for the mpmc_queue module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <stdalign.h>
+#include <sched.h>
+#include "mpmc_queue_p.h"
+
+/*
+The mpmc queue is a bounded circular buffer in which every slot carries
+a sequence number (the design of D. Vyukov's bounded MPMC queue).
+enqueue_pos and dequeue_pos are free-running positions; the slot for a
+position is (position & mask).
+
+For a slot at position p:
+  sequence == p      the slot is free, and may be claimed by the producer of p
+  sequence == p + 1  the slot holds a value, and may be claimed by the consumer of p
+A producer (consumer) claims a position with a CAS on enqueue_pos
+(dequeue_pos), copies the value in (out) and then publishes the slot by
+storing the next sequence number with release ordering. Producers and
+consumers only contend with each other on the slots themselves.
+*/
+typedef struct _mpmc_slot
+{
+  atomic_size_t sequence;
+  alignas(max_align_t) char data[]; // element_size bytes
+} *_mpmc_slot_p;
+
+/*
+The mpmc queue data type for the mpmc_queue module
+Slots is a char because pointer arithmetic is used
+*/
+typedef struct mpmc_queue
+{
+  // Read-only after creation
+  char *slots;
+  size_t mask;        // capacity - 1 (capacity is a power of two)
+  size_t slot_size;   // bytes per slot (sequence number + value, padded)
+  size_t element_size;
+
+  // Claimed by producers
+  alignas(CACHE_LINE_SIZE) atomic_size_t enqueue_pos;
+
+  // Claimed by consumers
+  alignas(CACHE_LINE_SIZE) atomic_size_t dequeue_pos;
+} *mpmc_queue_p;
+
+/*
+Creates and initialises a new empty mpmc queue using the mpmc_queue_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the queue
+  capacity - the maximum number of items in the queue
+             (rounded up to a power of two, minimum 2)
+
+Returns:
+  A mpmc_queue_p (pointer to the newly created queue)
+
+Throws:
+  aborts if the capacity is not positive or if the memory allocations fail
+
+*/
+mpmc_queue_p mpmc_queue_create(size_t element_size, int capacity)
+{
+  assert(capacity > 0 && "Error: Queue capacity must be positive");
+
+  mpmc_queue_p queue;
+  queue = (mpmc_queue_p)aligned_alloc(CACHE_LINE_SIZE, sizeof(struct mpmc_queue));
+  assert(queue != NULL && "Error in memory allocation");
+
+  // A single slot cannot distinguish full from empty
+  size_t slots = 2;
+  while (slots < (size_t)capacity)
+    slots <<= 1;
+
+  size_t align = alignof(struct _mpmc_slot);
+  queue->mask = slots - 1;
+  queue->element_size = element_size;
+  queue->slot_size = (sizeof(struct _mpmc_slot) + element_size + align - 1) / align * align;
+  queue->slots = aligned_alloc(CACHE_LINE_SIZE,
+                               (slots * queue->slot_size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE);
+  assert(queue->slots != NULL && "Error in memory allocation");
+
+  for (size_t i = 0; i < slots; i++)
+  {
+    atomic_init(&_mpmc_slot(queue, i)->sequence, i);
+  }
+  atomic_init(&queue->enqueue_pos, 0);
+  atomic_init(&queue->dequeue_pos, 0);
+
+  return queue;
+}
+
+/*
+Try to enqueue an item at the back/tail of the queue without blocking
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+  value - pointer to a variable containing the value of the item to be enqueued
+
+Returns:
+  MPMC_QUEUE_OK if the item was enqueued
+  MPMC_QUEUE_FULL if the queue is full
+
+*/
+mpmc_queue_status mpmc_queue_try_enqueue(mpmc_queue_p queue, const void *value)
+{
+  _mpmc_slot_p slot;
+  size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+
+  for (;;)
+  {
+    slot = _mpmc_slot(queue, pos);
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+    if (diff == 0)
+    {
+      // The slot is free: try to claim the position
+      // (on failure pos is updated to the current enqueue_pos)
+      if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // The slot still holds the value from the previous lap
+      return MPMC_QUEUE_FULL;
+    }
+    else
+    {
+      // Another producer claimed this position first
+      pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    }
+  }
+
+  memcpy(slot->data, value, queue->element_size);
+  atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+  return MPMC_QUEUE_OK;
+}
+
+/*
+Try to dequeue the item at the head of the queue without blocking
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+  out - pointer to a variable to store the value of the dequeued item
+
+Outputs:
+  out - the value of the dequeued item (unchanged if the queue is empty)
+
+Returns:
+  MPMC_QUEUE_OK if an item was dequeued
+  MPMC_QUEUE_EMPTY if the queue is empty
+
+*/
+mpmc_queue_status mpmc_queue_try_dequeue(mpmc_queue_p queue, void *out)
+{
+  _mpmc_slot_p slot;
+  size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+
+  for (;;)
+  {
+    slot = _mpmc_slot(queue, pos);
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+    if (diff == 0)
+    {
+      // The slot holds a value: try to claim the position
+      if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // The slot has not been filled yet
+      return MPMC_QUEUE_EMPTY;
+    }
+    else
+    {
+      // Another consumer claimed this position first
+      pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    }
+  }
+
+  memcpy(out, slot->data, queue->element_size);
+  // Free the slot for the producer of the next lap
+  atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);
+  return MPMC_QUEUE_OK;
+}
+
+/*
+Enqueue an item at the back/tail of the queue,
+yielding the processor while the queue is full
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+  value - pointer to a variable containing the value of the item to be enqueued
+
+Returns:
+  Nothing
+
+*/
+void mpmc_queue_enqueue(mpmc_queue_p queue, const void *value)
+{
+  while (mpmc_queue_try_enqueue(queue, value) != MPMC_QUEUE_OK)
+    sched_yield();
+}
+
+/*
+Dequeue the item at the head of the queue,
+yielding the processor while the queue is empty
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+  out - pointer to a variable to store the value of the dequeued item
+
+Outputs:
+  out - the value of the dequeued item
+
+Returns:
+  Nothing
+
+*/
+void mpmc_queue_dequeue(mpmc_queue_p queue, void *out)
+{
+  while (mpmc_queue_try_dequeue(queue, out) != MPMC_QUEUE_OK)
+    sched_yield();
+}
+
+/*
+Get the number of items currently in the queue.
+Positions that have been claimed but not yet published are counted.
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int mpmc_queue_size(mpmc_queue_p queue)
+{
+  size_t dequeue_pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+  size_t enqueue_pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+
+  // Consumers may have moved past enqueue_pos as read above
+  if (enqueue_pos < dequeue_pos)
+    return 0;
+  return (int)(enqueue_pos - dequeue_pos);
+}
+
+/*
+Frees the memory allocated to queue
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+
+Returns:
+  Nothing
+
+*/
+void mpmc_queue_delete(mpmc_queue_p queue)
+{
+  if (queue)
+  {
+    if (queue->slots)
+      free(queue->slots);
+    free(queue);
+  }
+}
+
+/*
+Internal function to perform pointer arithmetic
+
+Inputs:
+  queue - pointer to an instance of the mpmc queue type
+  position - a free-running enqueue or dequeue position
+
+Returns:
+  Pointer to the slot for position
+
+*/
+_mpmc_slot_p _mpmc_slot(mpmc_queue_p queue, size_t position)
+{
+  return (_mpmc_slot_p)(queue->slots + (position & queue->mask) * queue->slot_size);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file mpmc_queue.h
+ * @brief Public function prototypes for the mpmc_queue module
+ *
+ * Function prototypes required to use the mpmc_queue module.
+ * The mpmc queue is a bounded, lock-free queue which may be used by
+ * any number of producer and consumer threads at the same time.
+ * As for the queue module, values are copied in and out of the queue
+ * (element_size bytes at a time).
+ *
+ * Unlike queue_p there is no peek operation: with several consumers, the
+ * item at the head of the queue may be taken by another thread at any time.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+
+#ifndef MPMC_QUEUE
+#define MPMC_QUEUE
+
+/**
+ * @brief Data type represeting the mpmc queue
+ */
+typedef struct mpmc_queue *mpmc_queue_p;
+
+/**
+ * @brief Return codes for the non-blocking mpmc queue operations
+ */
+typedef enum mpmc_queue_status
+{
+  MPMC_QUEUE_OK = 0, // the operation succeeded
+  MPMC_QUEUE_FULL,   // enqueue failed because the queue is full
+  MPMC_QUEUE_EMPTY   // dequeue failed because the queue is empty
+} mpmc_queue_status;
+
+/**
+ * @brief create and initialise a new mpmc queue
+ *
+ * The initial size of the queue is zero.
+ * Example usage to create a queue of up to 1024 ints:
+ * mpmc_queue_p my_queue;
+ * my_queue = mpmc_queue_create(sizeof(int), 1024);
+ *
+ * @param[in] element_size The size of the data type to be stored in the queue
+ * @param[in] capacity The maximum number of items in the queue
+ *                     (rounded up to a power of two, minimum 2)
+ * @return A mpmc_queue_p (i.e. pointer to the queue data type) to the created queue
+ */
+mpmc_queue_p mpmc_queue_create(size_t element_size, int capacity);
+
+/**
+ * @brief try to add a new value to the back/tail of the queue without blocking
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @param[in] value pointer to a variable storing the value to be added to the queue
+ * @return MPMC_QUEUE_OK if the value was added, MPMC_QUEUE_FULL if the queue is full
+ */
+mpmc_queue_status mpmc_queue_try_enqueue(mpmc_queue_p queue, const void *value);
+
+/**
+ * @brief try to remove the item at the top/head of the queue without blocking
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ *                   (unchanged if the queue is empty)
+ * @return MPMC_QUEUE_OK if an item was dequeued, MPMC_QUEUE_EMPTY if the queue is empty
+ */
+mpmc_queue_status mpmc_queue_try_dequeue(mpmc_queue_p queue, void *out);
+
+/**
+ * @brief add a new value to the back/tail of the queue,
+ * waiting (yielding the processor) while the queue is full
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @param[in] value pointer to a variable storing the value to be added to the queue
+ * @return nothing
+ */
+void mpmc_queue_enqueue(mpmc_queue_p queue, const void *value);
+
+/**
+ * @brief Remove the item at the top/head of the queue,
+ * waiting (yielding the processor) while the queue is empty
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ * @return nothing
+ */
+void mpmc_queue_dequeue(mpmc_queue_p queue, void *out);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * When called while other threads are active, the result is a snapshot
+ * which may already be out of date.
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @return The number of items in the queue
+ */
+int mpmc_queue_size(mpmc_queue_p queue);
+
+/**
+ * @brief Delete the queue and deallocate memory
+ *
+ * Must not be called while other threads are using the queue.
+ *
+ * @param[in] queue A pointer to an instance of the mpmc_queue_p data type
+ * @return nothing
+ */
+void mpmc_queue_delete(mpmc_queue_p queue);
+
+#endif
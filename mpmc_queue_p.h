@@ -0,0 +1,31 @@
+/**
+ * mpmc_queue_p.h
+ *
+ * Private header file for mpmc_queue module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "mpmc_queue.h"
+
+#ifndef MPMC_QUEUE_P
+#define MPMC_QUEUE_P
+
+// Assumed size of a cache line.
+// The enqueue and dequeue positions are placed on separate cache lines
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Data type representing a slot in the queue buffer
+ * The element value (element_size bytes) follows the sequence number
+ */
+typedef struct _mpmc_slot *_mpmc_slot_p;
+
+_mpmc_slot_p _mpmc_slot(mpmc_queue_p queue, size_t position);
+
+#endif
@@ -0,0 +1,353 @@
+/**
+ * perf_counters.c
+ *
+ * Implementation of functions for the perf_counters module
+ *
+ * Each thread opens its own group of counters (on its first instrumented
+ * call) which count only that thread, in user space. A call reads the
+ * group at the start and the end (one read for all counters) and adds the
+ * differences to the totals of its operation type, which are shared by
+ * all threads (atomic adds). Reading the counters is a system call, so
+ * instrumented functions are much slower: compare the counts rather than
+ * the times with uninstrumented builds.
+ *
+ * @author ruairin
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "perf_counters_p.h"
+
+// The totals per operation: calls, nanoseconds, then each counter
+#define TOTAL_CALLS 0
+#define TOTAL_NANOSECONDS 1
+#define TOTAL_COUNTERS 2
+
+/*
+The event of each counter
+*/
+static const struct
+{
+  uint32_t type;
+  uint64_t config;
+} events[_PERF_NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+static const char *op_names[PERF_NUM_OPS] = {
+    "list_insert", "list_remove", "list_resize", "queue_enqueue", "queue_dequeue"};
+
+static atomic_llong totals[PERF_NUM_OPS][TOTAL_COUNTERS + _PERF_NUM_COUNTERS];
+
+// Bit c is set once counter c has been opened by any thread
+static atomic_int available;
+
+/*
+The counters of a thread. The group is read through its leader; slot
+is the position of each counter in the group (-1 if it could not be opened)
+*/
+typedef struct _perf_thread
+{
+  int fds[_PERF_NUM_COUNTERS];
+  int slot[_PERF_NUM_COUNTERS];
+  int leader;
+} _perf_thread;
+
+static _Thread_local _perf_thread *thread_counters = NULL;
+static _Thread_local bool thread_opened = false;
+
+// Closes the counters of a thread when it exits
+static pthread_key_t close_key;
+static pthread_once_t close_key_once = PTHREAD_ONCE_INIT;
+
+static void create_close_key(void)
+{
+  pthread_key_create(&close_key, _perf_close);
+}
+
+static long long now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/*
+Check whether the instrumentation is compiled in
+
+Returns:
+  true if built with DS_INSTRUMENT
+
+*/
+bool perf_counters_enabled(void)
+{
+#ifdef DS_INSTRUMENT
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*
+Get the totals for an operation type
+
+Inputs:
+  op - the operation type
+  stats - pointer to the totals to fill in
+
+Outputs:
+  stats - the totals (counters which are not available are -1)
+
+Returns:
+  Nothing
+
+*/
+void perf_counters_get(perf_op op, perf_stats *stats)
+{
+  long long counters[_PERF_NUM_COUNTERS];
+  int mask = atomic_load(&available);
+  for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+    counters[c] = (mask & (1 << c)) ? atomic_load(&totals[op][TOTAL_COUNTERS + c]) : -1;
+
+  stats->calls = atomic_load(&totals[op][TOTAL_CALLS]);
+  stats->nanoseconds = atomic_load(&totals[op][TOTAL_NANOSECONDS]);
+  stats->cycles = counters[_PERF_CYCLES];
+  stats->instructions = counters[_PERF_INSTRUCTIONS];
+  stats->llc_misses = counters[_PERF_LLC_MISSES];
+  stats->dtlb_misses = counters[_PERF_DTLB_MISSES];
+}
+
+/*
+Set the totals for all operation types to zero
+
+Returns:
+  Nothing
+
+*/
+void perf_counters_reset(void)
+{
+  for (int op = 0; op < PERF_NUM_OPS; op++)
+  {
+    for (int t = 0; t < TOTAL_COUNTERS + _PERF_NUM_COUNTERS; t++)
+      atomic_store(&totals[op][t], 0);
+  }
+}
+
+/*
+Print a table of the averages per call for each operation type which
+has been called (n/a for counters which are not available)
+
+Inputs:
+  out - the stream to print to
+
+Returns:
+  Nothing
+
+*/
+void perf_counters_dump(FILE *out)
+{
+  if (!perf_counters_enabled())
+  {
+    fprintf(out, "perf_counters: not compiled in (build with make INSTRUMENT=1)\n");
+    return;
+  }
+
+  fprintf(out, "%-14s %12s %10s %12s %12s %6s %14s %14s\n", "operation", "calls",
+          "ns/call", "cycles/call", "instr/call", "IPC", "LLC miss/call", "dTLB miss/call");
+  for (int op = 0; op < PERF_NUM_OPS; op++)
+  {
+    perf_stats stats;
+    perf_counters_get(op, &stats);
+    if (stats.calls == 0)
+      continue;
+
+    long long values[] = {stats.cycles, stats.instructions, stats.llc_misses, stats.dtlb_misses};
+    char columns[_PERF_NUM_COUNTERS][16];
+    for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+    {
+      if (values[c] < 0)
+        snprintf(columns[c], sizeof(columns[c]), "n/a");
+      else
+        snprintf(columns[c], sizeof(columns[c]), "%.2f", (double)values[c] / stats.calls);
+    }
+    char ipc[16] = "n/a";
+    if (stats.cycles > 0 && stats.instructions >= 0)
+      snprintf(ipc, sizeof(ipc), "%.2f", (double)stats.instructions / stats.cycles);
+
+    fprintf(out, "%-14s %12lld %10.1f %12s %12s %6s %14s %14s\n", op_names[op], stats.calls,
+            (double)stats.nanoseconds / stats.calls, columns[_PERF_CYCLES],
+            columns[_PERF_INSTRUCTIONS], ipc, columns[_PERF_LLC_MISSES], columns[_PERF_DTLB_MISSES]);
+  }
+}
+
+/*
+Internal function called at the start of an instrumented call
+
+Inputs:
+  sample - pointer to the sample for the call
+
+Outputs:
+  sample - the time and the counters at the start of the call
+
+Returns:
+  Nothing
+
+*/
+void _perf_begin(_perf_sample *sample)
+{
+  if (_perf_open())
+    _perf_read(sample->counters);
+  sample->nanoseconds = now_ns();
+}
+
+/*
+Internal function called at the end of an instrumented call,
+to add the call to the totals of its operation type
+
+Inputs:
+  sample - pointer to the sample from _perf_begin
+  op - the operation type
+
+Returns:
+  Nothing
+
+*/
+void _perf_end(_perf_sample *sample, perf_op op)
+{
+  long long elapsed = now_ns() - sample->nanoseconds;
+  atomic_fetch_add_explicit(&totals[op][TOTAL_CALLS], 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&totals[op][TOTAL_NANOSECONDS], elapsed, memory_order_relaxed);
+
+  if (thread_counters)
+  {
+    long long counters[_PERF_NUM_COUNTERS];
+    _perf_read(counters);
+    for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+    {
+      if (thread_counters->slot[c] >= 0)
+        atomic_fetch_add_explicit(&totals[op][TOTAL_COUNTERS + c],
+                                  counters[c] - sample->counters[c], memory_order_relaxed);
+    }
+  }
+}
+
+/*
+Internal function to open the counters of the calling thread (once).
+Each counter which cannot be opened is left out of the group
+
+Returns:
+  true if at least one counter is open for the thread
+
+*/
+bool _perf_open(void)
+{
+  if (thread_opened)
+    return thread_counters != NULL;
+  thread_opened = true;
+
+  _perf_thread *counters = malloc(sizeof(_perf_thread));
+  if (counters == NULL)
+    return false;
+
+  int count = 0;
+  counters->leader = -1;
+  for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[c].type;
+    attr.config = events[c].config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    counters->fds[c] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, counters->leader, 0);
+    counters->slot[c] = -1;
+    if (counters->fds[c] >= 0)
+    {
+      if (counters->leader < 0)
+        counters->leader = counters->fds[c];
+      counters->slot[c] = count++;
+      atomic_fetch_or(&available, 1 << c);
+    }
+  }
+
+  if (count == 0)
+  {
+    free(counters);
+    return false;
+  }
+
+  pthread_once(&close_key_once, create_close_key);
+  pthread_setspecific(close_key, counters);
+  thread_counters = counters;
+  return true;
+}
+
+/*
+Internal function to read the counters of the calling thread
+
+Inputs:
+  counters - array for the value of each counter
+
+Outputs:
+  counters - the value of each open counter
+
+Returns:
+  Nothing
+
+*/
+void _perf_read(long long counters[_PERF_NUM_COUNTERS])
+{
+  struct
+  {
+    uint64_t count;
+    uint64_t values[_PERF_NUM_COUNTERS];
+  } group = {0, {0}};
+
+  if (read(thread_counters->leader, &group, sizeof(group)) <= 0)
+    group.count = 0;
+
+  for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+  {
+    int slot = thread_counters->slot[c];
+    counters[c] = (slot >= 0 && (uint64_t)slot < group.count) ? (long long)group.values[slot] : 0;
+  }
+}
+
+/*
+Internal function to close the counters of a thread (when it exits)
+
+Inputs:
+  arg - pointer to the counters of the thread
+
+Returns:
+  Nothing
+
+*/
+void _perf_close(void *arg)
+{
+  _perf_thread *counters = arg;
+  for (int c = 0; c < _PERF_NUM_COUNTERS; c++)
+  {
+    if (counters->slot[c] >= 0)
+      close(counters->fds[c]);
+  }
+  free(counters);
+  thread_counters = NULL;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file perf_counters.h
+ * @brief Public function prototypes for the perf_counters module
+ *
+ * Instrumentation of the hot list and queue functions (list_insert,
+ * list_remove, the list resize, queue_enqueue and queue_dequeue) with
+ * hardware performance counters (via perf_event_open): cycles,
+ * instructions, last level cache misses and data TLB misses, as well as
+ * the number of calls and the elapsed time. The counts are totalled per
+ * operation type over all threads, and can be read or printed at any time.
+ *
+ * The instrumentation is only compiled in with -DDS_INSTRUMENT
+ * (``$ make INSTRUMENT=1``); otherwise these functions report no calls.
+ * Counters which the system does not provide (e.g. in a VM without a
+ * virtual PMU, or when perf_event_paranoid forbids them) are reported
+ * as unavailable, and the calls and times are still recorded.
+ *
+ * The counts are inclusive: a list_insert which resizes the list is
+ * counted in full under PERF_LIST_INSERT, and its resize under
+ * PERF_LIST_RESIZE as well.
+ *
+ * Example usage:
+ * perf_counters_reset();
+ * ... list and queue operations ...
+ * perf_counters_dump(stdout);
+ *
+ * @author ruairin
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS
+
+/**
+ * @brief The instrumented operations
+ */
+typedef enum perf_op
+{
+  PERF_LIST_INSERT = 0,
+  PERF_LIST_REMOVE,
+  PERF_LIST_RESIZE,
+  PERF_QUEUE_ENQUEUE,
+  PERF_QUEUE_DEQUEUE,
+  PERF_NUM_OPS
+} perf_op;
+
+/**
+ * @brief The totals for an operation type
+ *
+ * Counters which are not available are -1.
+ */
+typedef struct perf_stats
+{
+  long long calls;
+  long long nanoseconds;
+  long long cycles;
+  long long instructions;
+  long long llc_misses;
+  long long dtlb_misses;
+} perf_stats;
+
+/**
+ * @brief Check whether the instrumentation is compiled in (-DDS_INSTRUMENT)
+ *
+ * @return true if the instrumented functions record their calls
+ */
+bool perf_counters_enabled(void);
+
+/**
+ * @brief Get the totals for an operation type
+ *
+ * @param[in] op The operation type
+ * @param[out] stats The totals since the start of the program or the last reset
+ * @return nothing
+ */
+void perf_counters_get(perf_op op, perf_stats *stats);
+
+/**
+ * @brief Set the totals for all operation types to zero
+ *
+ * @return nothing
+ */
+void perf_counters_reset(void);
+
+/**
+ * @brief Print a table of the totals (and the averages per call)
+ *        for each operation type which has been called
+ *
+ * @param[in] out The stream to print to (e.g. stdout)
+ * @return nothing
+ */
+void perf_counters_dump(FILE *out);
+
+#endif
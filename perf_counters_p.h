@@ -0,0 +1,56 @@
+/**
+ * perf_counters_p.h
+ *
+ * Private header file for perf_counters module,
+ * including the hooks used by the instrumented functions
+ *
+ * @author ruairin
+ *
+ */
+
+#include "perf_counters.h"
+
+#ifndef PERF_COUNTERS_P
+#define PERF_COUNTERS_P
+
+// The hardware counters, in the order they are opened
+typedef enum _perf_counter
+{
+  _PERF_CYCLES = 0,
+  _PERF_INSTRUCTIONS,
+  _PERF_LLC_MISSES,
+  _PERF_DTLB_MISSES,
+  _PERF_NUM_COUNTERS
+} _perf_counter;
+
+/**
+ * @brief The counters at the start of an instrumented call
+ */
+typedef struct _perf_sample
+{
+  long long counters[_PERF_NUM_COUNTERS];
+  long long nanoseconds;
+} _perf_sample;
+
+/*
+Hooks for the instrumented functions. PERF_BEGIN goes at the start of the
+function and PERF_END(op) before each return. Without DS_INSTRUMENT they
+compile to nothing
+*/
+#ifdef DS_INSTRUMENT
+#define PERF_BEGIN() \
+  _perf_sample _perf; \
+  _perf_begin(&_perf)
+#define PERF_END(op) _perf_end(&_perf, op)
+#else
+#define PERF_BEGIN()
+#define PERF_END(op)
+#endif
+
+void _perf_begin(_perf_sample *sample);
+void _perf_end(_perf_sample *sample, perf_op op);
+bool _perf_open(void);
+void _perf_read(long long counters[_PERF_NUM_COUNTERS]);
+void _perf_close(void *arg);
+
+#endif
@@ -9,15 +9,27 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <sys/mman.h>
+#include "queue.h"
+#include "serialize_p.h"
+#include "perf_counters_p.h"
+
+// The number of items gathered into a buffer for each write by queue_save
+// (a multiple of 8, so each buffer is a whole number of checksum words)
+#define SAVE_BATCH 4096
 
 /*
 The queue is based on a linked data structure.
-_element is a (private) data type representing a queue element
+_element is a (private) data type representing a queue element.
+The data is stored inline (flexible array member), so the element and its
+data are one allocation of queue_node_size(element_size) bytes
 */
 typedef struct _element
 {
-  char *data; // The data stored in this the element
-  struct _element *next; // pointer to the next element 
+  struct _element *next; // pointer to the next element
+  alignas(max_align_t) char data[]; // The data stored in this the element
 } *_element_p;
 
 
@@ -30,8 +42,32 @@ typedef struct queue
   _element_p tail; // back of the queue
   int length;
   size_t element_size;
+  allocator alloc; // source of the memory for the queue and its elements
+  queue_statistics stats; // only updated when built with DS_STATS
 } *queue_p;
 
+/*
+Updates a statistic of the queue (only when built with DS_STATS)
+*/
+#ifdef DS_STATS
+#define QUEUE_STAT(statement) statement
+#else
+#define QUEUE_STAT(statement)
+#endif
+
+/*
+Internal function to record a new peak length (only when built with DS_STATS)
+*/
+static inline void _note_length(queue_p queue)
+{
+#ifdef DS_STATS
+  if (queue->length > queue->stats.peak_length)
+    queue->stats.peak_length = queue->length;
+#else
+  (void)queue;
+#endif
+}
+
 /*
 Creates and initialises a new empty queue using the queue_p type
 
@@ -47,16 +83,39 @@ Throws:
 */
 
 queue_p queue_create(size_t element_size)
+{
+  allocator alloc = allocator_default();
+  return queue_create_ex(element_size, &alloc);
+}
+
+/*
+Creates and initialises a new empty queue whose memory (the queue
+itself and its elements) comes from the given allocator
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the queue
+  alloc - the allocator (copied into the queue)
+
+Returns:
+  A queue_p (pointer to the newly created queue)
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+queue_p queue_create_ex(size_t element_size, const allocator *alloc)
 {
   queue_p queue;
 
-  queue = (queue_p)malloc(sizeof(struct queue));
+  queue = (queue_p)alloc->alloc(alloc->ctx, sizeof(struct queue));
   assert(queue != NULL && "Error in memory allocation");
 
+  queue->alloc = *alloc;
   queue->head = NULL;
   queue->tail = NULL;
   queue->length = 0;
   queue->element_size = element_size;
+  memset(&queue->stats, 0, sizeof(queue->stats));
 
   return queue;
 }
@@ -104,13 +163,11 @@ Throws:
 */
 void queue_enqueue(queue_p queue, void *value)
 {
+  PERF_BEGIN();
   _element_p new_element;
-  new_element = (_element_p)malloc(sizeof(struct _element));
+  new_element = (_element_p)queue->alloc.alloc(queue->alloc.ctx, queue_node_size(queue->element_size));
   assert(new_element != NULL && "Error in memory allocation");
 
-  new_element->data = malloc(queue->element_size);
-  assert(new_element->data != NULL && "Error in memory allocation");
-
   new_element->next = NULL;
   memcpy(new_element->data, value, queue->element_size);
 
@@ -124,6 +181,10 @@ void queue_enqueue(queue_p queue, void *value)
   }
   queue->tail = new_element;
   queue->length++;
+  QUEUE_STAT(queue->stats.enqueues++);
+  QUEUE_STAT(queue->stats.allocations++);
+  _note_length(queue);
+  PERF_END(PERF_QUEUE_ENQUEUE);
 }
 
 /*
@@ -143,23 +204,273 @@ Returns:
 */
 void queue_dequeue(queue_p queue, void *out)
 {
+  PERF_BEGIN();
   if (queue->head != NULL)
   {
     memcpy(out, queue->head->data, queue->element_size);
 
     _element_p temp = queue->head->next;
-    if (queue->head->data != NULL)
-    {
-      free(queue->head->data);
-    }
-    free(queue->head);
+    queue->alloc.free(queue->alloc.ctx, queue->head, queue_node_size(queue->element_size));
     queue->head = temp;
     queue->length--;
+    QUEUE_STAT(queue->stats.dequeues++);
+    QUEUE_STAT(queue->stats.frees++);
   }
   else
   {
     out = NULL;
   }
+  PERF_END(PERF_QUEUE_DEQUEUE);
+}
+
+/*
+Enqueue count items at the back/tail of the queue.
+The new elements are linked into a chain which is then spliced onto
+the tail, so the queue itself is only updated once
+
+Inputs:
+  queue - pointer to an instance of the queue type
+  src - pointer to an array of count values to be enqueued
+  count - the number of values in src
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void queue_enqueue_n(queue_p queue, const void *src, int count)
+{
+  if (count <= 0)
+    return;
+
+  size_t node_size = queue_node_size(queue->element_size);
+  const char *value = src;
+  _element_p first = NULL;
+  _element_p last = NULL;
+  for (int i = 0; i < count; i++)
+  {
+    _element_p new_element = (_element_p)queue->alloc.alloc(queue->alloc.ctx, node_size);
+    assert(new_element != NULL && "Error in memory allocation");
+
+    memcpy(new_element->data, value, queue->element_size);
+    value += queue->element_size;
+    if (last)
+      last->next = new_element;
+    else
+      first = new_element;
+    last = new_element;
+  }
+  last->next = NULL;
+
+  if (queue->head == NULL)
+  {
+    queue->head = first;
+  }
+  else
+  {
+    queue->tail->next = first;
+  }
+  queue->tail = last;
+  queue->length += count;
+  QUEUE_STAT(queue->stats.enqueues += count);
+  QUEUE_STAT(queue->stats.allocations += count);
+  _note_length(queue);
+}
+
+/*
+Dequeue up to max items from the head of the queue
+
+Inputs:
+  queue - pointer to an instance of the queue type
+  dst - pointer to an array with room for max values
+  max - the maximum number of items to dequeue
+  got - pointer to a variable to store the number of items dequeued
+
+Outputs:
+  dst - the dequeued values, in queue order
+  got - the number of items dequeued
+
+Returns:
+  Nothing
+
+*/
+void queue_dequeue_n(queue_p queue, void *dst, int max, int *got)
+{
+  size_t node_size = queue_node_size(queue->element_size);
+  char *out = dst;
+  _element_p current = queue->head;
+  int count = 0;
+  while (current && count < max)
+  {
+    _element_p next = current->next;
+    memcpy(out, current->data, queue->element_size);
+    out += queue->element_size;
+    queue->alloc.free(queue->alloc.ctx, current, node_size);
+    current = next;
+    count++;
+  }
+
+  queue->head = current;
+  queue->length -= count;
+  QUEUE_STAT(queue->stats.dequeues += count);
+  QUEUE_STAT(queue->stats.frees += count);
+  *got = count;
+}
+
+/*
+Dequeue every item in the queue, passing each to a callback.
+The chain of elements is detached before the callback is called,
+so the callback can safely enqueue to the same queue
+
+Inputs:
+  queue - pointer to an instance of the queue type
+  callback - function called with each value (in queue order) and ctx
+  ctx - pointer passed through to the callback
+
+Returns:
+  The number of items drained
+
+*/
+int queue_drain(queue_p queue, void (*callback)(const void *value, void *ctx), void *ctx)
+{
+  size_t node_size = queue_node_size(queue->element_size);
+  _element_p current = queue->head;
+  int count = queue->length;
+
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->length = 0;
+
+  while (current)
+  {
+    _element_p next = current->next;
+    callback(current->data, ctx);
+    queue->alloc.free(queue->alloc.ctx, current, node_size);
+    current = next;
+  }
+  QUEUE_STAT(queue->stats.dequeues += count);
+  QUEUE_STAT(queue->stats.frees += count);
+  return count;
+}
+
+/*
+Get the number of items currently in the queue
+
+Inputs:
+  queue - pointer to an instance of the queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int queue_size(queue_p queue)
+{
+  return queue->length;
+}
+
+/*
+Gets the operation statistics of the queue
+(which are only kept when built with DS_STATS)
+
+Inputs:
+  queue - pointer to an instance of the queue type
+  stats - pointer to the statistics to fill in
+
+Outputs:
+  stats - the statistics (all zero unless built with DS_STATS)
+
+Returns:
+  true if statistics are kept
+
+*/
+bool queue_stats(queue_p queue, queue_statistics *stats)
+{
+#ifdef DS_STATS
+  *stats = queue->stats;
+  return true;
+#else
+  (void)queue;
+  memset(stats, 0, sizeof(*stats));
+  return false;
+#endif
+}
+
+/*
+Saves the items of the queue (head first) to a file.
+The items are gathered into a buffer, so the file is written in
+large blocks rather than an item at a time
+
+Inputs:
+  queue - pointer to an instance of the queue type
+  path - the path of the file (replaced if it exists)
+
+Returns:
+  0 on success, -1 if the file could not be written
+
+Throws:
+  aborts if the memory allocation fails
+
+*/
+int queue_save(queue_p queue, const char *path)
+{
+  FILE *file = _serial_begin(path);
+  if (file == NULL)
+    return -1;
+
+  char *buffer = malloc(SAVE_BATCH * queue->element_size);
+  assert(buffer != NULL && "Error in memory allocation");
+
+  uint64_t checksum = CHECKSUM_SEED;
+  bool ok = true;
+  _element_p current = queue->head;
+  while (current && ok)
+  {
+    size_t batch = 0;
+    for (; current && batch < SAVE_BATCH; current = current->next, batch++)
+      memcpy(buffer + batch * queue->element_size, current->data, queue->element_size);
+
+    size_t bytes = batch * queue->element_size;
+    checksum = _checksum(checksum, buffer, bytes);
+    ok = fwrite(buffer, 1, bytes, file) == bytes;
+  }
+  free(buffer);
+
+  if (!ok)
+  {
+    fclose(file);
+    return -1;
+  }
+  return _serial_end(file, queue->element_size, queue->length, checksum);
+}
+
+/*
+Loads a queue saved by queue_save or list_save
+
+Inputs:
+  path - the path of the file
+  element_size - the size of the primitive data type to be stored in the queue
+
+Returns:
+  A queue_p (pointer to the queue), or NULL if the file cannot be read
+  or is not valid
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+queue_p queue_load(const char *path, size_t element_size)
+{
+  size_t length, count;
+  char *map = _serial_map(path, element_size, &length, &count);
+  if (map == NULL)
+    return NULL;
+
+  queue_p queue = queue_create(element_size);
+  queue_enqueue_n(queue, map + SERIAL_HEADER_SIZE, (int)count);
+  munmap(map, length);
+  return queue;
 }
 
 /*
@@ -176,17 +487,34 @@ void queue_delete(queue_p queue)
 {
   if (queue)
   {
+    // Copy the allocator, as it is stored in the queue being freed
+    allocator alloc = queue->alloc;
+    size_t node_size = queue_node_size(queue->element_size);
     if (queue->head)
     {
       _element_p current = queue->head;
       while (current)
       {
         _element_p next = current->next;
-        free(current->data);
-        free(current);
+        alloc.free(alloc.ctx, current, node_size);
         current = next;
       }
     }
-    free(queue);
+    alloc.free(alloc.ctx, queue, sizeof(struct queue));
   }
 }
+
+/*
+Get the number of bytes allocated for each queue element
+
+Inputs:
+  element_size - the size of the primitive data type stored in the queue
+
+Returns:
+  The size of an element (with its data)
+
+*/
+size_t queue_node_size(size_t element_size)
+{
+  return offsetof(struct _element, data) + element_size;
+}
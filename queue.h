@@ -8,7 +8,9 @@
  */
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include "queue_p.h"
+#include "allocator.h"
 
 #ifndef QUEUE
 #define QUEUE
@@ -18,6 +20,18 @@
  */
 typedef struct queue *queue_p;
 
+/**
+ * @brief Operation statistics for a queue (see queue_stats)
+ */
+typedef struct queue_statistics
+{
+  long long enqueues;    // items enqueued
+  long long dequeues;    // items dequeued (or drained)
+  long long allocations; // elements allocated
+  long long frees;       // elements freed
+  int peak_length;       // largest number of items in the queue
+} queue_statistics;
+
 /**
  * @brief create and initialise a new queue
  *
@@ -31,6 +45,21 @@ typedef struct queue *queue_p;
  */
 queue_p queue_create(size_t element_size);
 
+/**
+ * @brief create and initialise a new queue using a custom allocator
+ *
+ * The queue itself and each of its elements are allocated from alloc
+ * (see allocator.h). Each element is one allocation of
+ * queue_node_size(element_size) bytes, so a pool created with that
+ * object size serves all of the queue's elements from its free list.
+ * The allocator (and its context) must outlive the queue.
+ *
+ * @param[in] element_size The size of the data type to be stored in the queue
+ * @param[in] alloc The allocator (the function table is copied)
+ * @return A queue_p (i.e. pointer to the queue data type) to the created queue
+ */
+queue_p queue_create_ex(size_t element_size, const allocator *alloc);
+
 /**
  * @brief get the value at the top/head of the queue
  *
@@ -58,6 +87,94 @@ void queue_enqueue(queue_p queue, void *value);
  */
 void queue_dequeue(queue_p queue, void *out);
 
+/**
+ * @brief add count values to the back/tail of the queue
+ *
+ * Equivalent to calling queue_enqueue for each value in src in order,
+ * but the elements are linked together first and spliced onto the
+ * queue once.
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @param[in] src pointer to an array of count values to be added to the queue
+ * @param[in] count The number of values in src
+ * @return nothing
+ */
+void queue_enqueue_n(queue_p queue, const void *src, int count);
+
+/**
+ * @brief Remove up to max items from the top/head of the queue
+ *
+ * The dequeued values are copied to dst in queue order.
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @param[inout] dst pointer to an array with room for max values
+ * @param[in] max The maximum number of items to dequeue
+ * @param[inout] got pointer to a variable storing the number of items dequeued
+ * @return nothing
+ */
+void queue_dequeue_n(queue_p queue, void *dst, int max, int *got);
+
+/**
+ * @brief Remove every item from the queue, passing each to a callback
+ *
+ * The items are detached from the queue before the callback is called,
+ * so the callback may enqueue to the same queue; those items are left
+ * in the queue for the next drain.
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @param[in] callback Function called with each value (in queue order) and ctx
+ * @param[in] ctx Pointer passed through to the callback
+ * @return The number of items drained
+ */
+int queue_drain(queue_p queue, void (*callback)(const void *value, void *ctx), void *ctx);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @return The number of items in the queue
+ */
+int queue_size(queue_p queue);
+
+/**
+ * @brief Get the operation statistics of the queue
+ *
+ * The statistics are only kept when built with -DDS_STATS (``$ make STATS=1``),
+ * so that other builds pay nothing for them; otherwise they are all zero.
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @param[out] stats The statistics
+ * @return true if statistics are kept (built with DS_STATS)
+ */
+bool queue_stats(queue_p queue, queue_statistics *stats);
+
+/**
+ * @brief Save the items of the queue (head first) to a file
+ *
+ * Uses the same file format as list_save, so the file can be loaded
+ * with queue_load or list_load.
+ *
+ * @param[in] queue A pointer to an instance of the queue_p data type
+ * @param[in] path The path of the file (replaced if it exists)
+ * @return 0 on success, -1 if the file could not be written
+ */
+int queue_save(queue_p queue, const char *path);
+
+/**
+ * @brief Load a queue saved by queue_save (or list_save)
+ *
+ * The file is mapped and the items are enqueued directly from the
+ * mapping (as by queue_enqueue_n).
+ *
+ * @param[in] path The path of the file
+ * @param[in] element_size The size of the data type stored in the queue
+ *                         (must match the file)
+ * @return A queue_p (i.e. pointer to the queue data type), or NULL if the file
+ *         cannot be read, is not a saved file of element_size items,
+ *         or fails its checksum
+ */
+queue_p queue_load(const char *path, size_t element_size);
+
 /**
  * @brief Delete the queue and deallocate memory
  *
@@ -66,4 +183,12 @@ void queue_dequeue(queue_p queue, void *out);
  */
 void queue_delete(queue_p queue);
 
+/**
+ * @brief Get the number of bytes allocated for each element of a queue
+ *
+ * @param[in] element_size The size of the data type stored in the queue
+ * @return The allocation size of one queue element
+ */
+size_t queue_node_size(size_t element_size);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,244 @@
+/**
+ * ring_queue.c
+ *
+ * Implementation of functions for the ring_queue module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "ring_queue_p.h"
+
+// The initial capacity of the buffer
+// Must be a power of two (see _ring_slot)
+#define INITIAL_CAPACITY 16
+
+// The factor by which the buffer grows when
+// its capacity is exceeded (as for _grow_array in array_list.c)
+#define CAPACITY_GROW_FACTOR 2
+
+/*
+The ring queue stores elements inline in a single circular buffer.
+head is the buffer position of the top of the queue and the
+elements occupy length consecutive positions (modulo capacity) from there.
+Data is a char because pointer arithmetic is used
+*/
+typedef struct ring_queue
+{
+  char *data;
+  int head;     // buffer position of the top of the queue
+  int length;   // number of elements in the queue
+  int capacity; // number of element slots in data (a power of two)
+  size_t element_size;
+} *ring_queue_p;
+
+/*
+Creates and initialises a new empty ring queue using the ring_queue_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the queue
+
+Returns:
+  A ring_queue_p (pointer to the newly created queue)
+
+Throws:
+  aborts if the memory allocations fail
+
+*/
+ring_queue_p ring_queue_create(size_t element_size)
+{
+  ring_queue_p queue;
+
+  queue = (ring_queue_p)malloc(sizeof(struct ring_queue));
+  assert(queue != NULL && "Error in memory allocation");
+
+  queue->head = 0;
+  queue->length = 0;
+  queue->capacity = INITIAL_CAPACITY;
+  queue->element_size = element_size;
+  queue->data = malloc(queue->capacity * queue->element_size);
+  assert(queue->data != NULL && "Error in memory allocation");
+
+  return queue;
+}
+
+/*
+Get the value of the item at the top/head of the queue
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+  out - pointer to a variable to store the value at the top of the queue
+
+Outputs:
+  out - the value at the top of the queue (unchanged if the queue is empty)
+
+Returns:
+  Nothing
+
+*/
+void ring_queue_peek(ring_queue_p queue, void *out)
+{
+  if (queue->length > 0)
+  {
+    memcpy(out, _ring_slot(queue, 0), queue->element_size);
+  }
+}
+
+/*
+Enqueue an item at the back/tail of the queue
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+  value - pointer to a variable containing the value of the item to be enqueued
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void ring_queue_enqueue(ring_queue_p queue, void *value)
+{
+  if (_is_ring_full(queue))
+  {
+    _grow_ring(queue);
+  }
+
+  memcpy(_ring_slot(queue, queue->length), value, queue->element_size);
+  queue->length++;
+}
+
+/*
+Dequeue the item at the head of the queue
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+  out - pointer to a variable to store the value of the dequeued item
+
+Outputs:
+  out - the value of the dequeued item (unchanged if the queue is empty)
+
+Returns:
+  Nothing
+
+*/
+void ring_queue_dequeue(ring_queue_p queue, void *out)
+{
+  if (queue->length > 0)
+  {
+    memcpy(out, _ring_slot(queue, 0), queue->element_size);
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->length--;
+  }
+}
+
+/*
+Get the number of items currently in the queue
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int ring_queue_size(ring_queue_p queue)
+{
+  return queue->length;
+}
+
+/*
+Frees the memory allocated to queue
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+
+Returns:
+  Nothing
+
+*/
+void ring_queue_delete(ring_queue_p queue)
+{
+  if (queue)
+  {
+    if (queue->data)
+      free(queue->data);
+    free(queue);
+  }
+}
+
+/*
+Internal function to check if the buffer is full
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+
+Returns:
+  True if the buffer is full
+  False otherwise
+
+*/
+bool _is_ring_full(ring_queue_p queue)
+{
+  if (queue->length >= queue->capacity)
+    return true;
+  return false;
+}
+
+/*
+Internal function to grow the buffer by CAPACITY_GROW_FACTOR.
+
+If the elements wrap around the end of the old buffer, the wrapped
+part (from position 0) is moved to just after the old end of the buffer
+so that the elements are consecutive again in the larger buffer.
+Since the capacity at least doubles, the wrapped part always fits.
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+
+Outputs:
+  queue - resized queue->data buffer, updated queue->capacity
+
+Returns:
+  Nothing
+
+Throws:
+  aborts if memory allocation fails
+*/
+void _grow_ring(ring_queue_p queue)
+{
+  int old_capacity = queue->capacity;
+  int new_capacity = old_capacity * CAPACITY_GROW_FACTOR;
+
+  queue->data = realloc(queue->data, new_capacity * queue->element_size);
+  assert(queue->data != NULL && "Error: Cannot resize queue (Memory allocation failed).\n");
+
+  int wrapped = queue->head + queue->length - old_capacity;
+  if (wrapped > 0)
+  {
+    memcpy(queue->data + old_capacity * queue->element_size,
+           queue->data,
+           wrapped * queue->element_size);
+  }
+  queue->capacity = new_capacity;
+}
+
+/*
+Internal function to perform pointer arithmetic
+
+Inputs:
+  queue - pointer to an instance of the ring queue type
+  position - the position relative to the head of the queue
+
+Returns:
+  Pointer to the buffer slot at position
+
+*/
+void *_ring_slot(ring_queue_p queue, int position)
+{
+  int index = (queue->head + position) & (queue->capacity - 1);
+  return queue->data + index * queue->element_size;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ring_queue.h
+ * @brief Public function prototypes for the ring_queue module
+ *
+ * Function prototypes required to use the ring_queue module.
+ * The API mirrors the queue module, but elements are stored inline in a
+ * single growable circular buffer rather than in individually allocated
+ * linked elements.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+
+#ifndef RING_QUEUE
+#define RING_QUEUE
+
+/**
+ * @brief Data type represeting the ring queue
+ */
+typedef struct ring_queue *ring_queue_p;
+
+/**
+ * @brief create and initialise a new ring queue
+ *
+ * The initial size of the queue is zero.
+ * Example usage to create a queue of ints:
+ * ring_queue_p my_queue;
+ * my_queue = ring_queue_create(sizeof(int));
+ *
+ * @param[in] element_size The size of the data type to be stored in the queue
+ * @return A ring_queue_p (i.e. pointer to the queue data type) to the created queue
+ */
+ring_queue_p ring_queue_create(size_t element_size);
+
+/**
+ * @brief get the value at the top/head of the queue
+ *
+ * If the queue is empty, out is left unchanged.
+ *
+ * @param[in] queue A pointer to an instance of the ring_queue_p data type
+ * @param[inout] out pointer to a variable storing the value at the top of the queue
+ * @return nothing
+ */
+void ring_queue_peek(ring_queue_p queue, void *out);
+
+/**
+ * @brief add a new value to the back/tail of the queue
+ *
+ * The buffer doubles in size when full. Once the queue has reached its
+ * working size, enqueue performs no memory allocation.
+ *
+ * @param[in] queue A pointer to an instance of the ring_queue_p data type
+ * @param[in] value pointer to a variable storing the value to be added to the queue
+ * @return nothing
+ */
+void ring_queue_enqueue(ring_queue_p queue, void *value);
+
+/**
+ * @brief Remove the item at the top/head of the queue
+ *
+ * If the queue is empty, out is left unchanged.
+ *
+ * @param[in] queue A pointer to an instance of the ring_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ * @return nothing
+ */
+void ring_queue_dequeue(ring_queue_p queue, void *out);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * @param[in] queue A pointer to an instance of the ring_queue_p data type
+ * @return The number of items in the queue
+ */
+int ring_queue_size(ring_queue_p queue);
+
+/**
+ * @brief Delete the queue and deallocate memory
+ *
+ * @param[in] queue A pointer to an instance of the ring_queue_p data type
+ * @return nothing
+ */
+void ring_queue_delete(ring_queue_p queue);
+
+#endif
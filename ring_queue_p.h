@@ -0,0 +1,20 @@
+/**
+ * ring_queue_p.h
+ *
+ * Private header file for ring_queue module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdbool.h>
+#include "ring_queue.h"
+
+#ifndef RING_QUEUE_P
+#define RING_QUEUE_P
+
+bool _is_ring_full(ring_queue_p queue);
+void _grow_ring(ring_queue_p queue);
+void *_ring_slot(ring_queue_p queue, int position);
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * scheduler.c
+ *
+ * Implementation of functions for the scheduler module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "scheduler_p.h"
+#include "ws_deque.h"
+#include "blocking_queue.h"
+
+// The initial capacity of each worker's deque (it grows as needed)
+#define DEQUE_CAPACITY 256
+
+// The number of fruitless searches for a task before an idle worker
+// sleeps on the injection queue, and how long it sleeps for.
+// Tasks pushed to a worker's deque do not wake sleeping workers, so
+// the sleep is kept short
+#define IDLE_SPINS 64
+#define IDLE_SLEEP_MS 1
+
+/*
+A task as stored in the deques and the injection queue
+*/
+struct _task
+{
+  void (*fn)(void *arg);
+  void *arg;
+  task_group *group;
+};
+
+/*
+A worker thread and its deque. random is the state of the
+xorshift generator used to choose a victim to steal from
+*/
+typedef struct _worker
+{
+  scheduler_p sched;
+  ws_deque_p deque;
+  uint32_t random;
+  pthread_t thread;
+} *_worker_p;
+
+/*
+The scheduler data type for the scheduler module
+*/
+typedef struct scheduler
+{
+  _worker_p workers;
+  int num_workers;
+  blocking_queue_p injection; // tasks spawned by non-worker threads
+  atomic_bool stop;
+} *scheduler_p;
+
+// The worker running on the current thread (NULL on other threads)
+static _Thread_local _worker_p current_worker = NULL;
+
+/*
+Creates a scheduler and starts its worker threads
+
+Inputs:
+  num_workers - the number of worker threads (0 for one per online CPU)
+
+Returns:
+  A scheduler_p (pointer to the newly created scheduler)
+
+Throws:
+  aborts if num_workers is negative or if the memory allocations fail
+
+*/
+scheduler_p scheduler_create(int num_workers)
+{
+  assert(num_workers >= 0 && "Error: The number of workers must not be negative");
+  if (num_workers == 0)
+  {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_workers = cpus > 0 ? (int)cpus : 1;
+  }
+
+  scheduler_p sched;
+  sched = (scheduler_p)malloc(sizeof(struct scheduler));
+  assert(sched != NULL && "Error in memory allocation");
+
+  sched->workers = (_worker_p)malloc(num_workers * sizeof(struct _worker));
+  assert(sched->workers != NULL && "Error in memory allocation");
+
+  sched->num_workers = num_workers;
+  sched->injection = blocking_queue_create(sizeof(_task), 0);
+  atomic_init(&sched->stop, false);
+
+  // All of the deques must exist before any worker tries to steal
+  for (int i = 0; i < num_workers; i++)
+  {
+    sched->workers[i].sched = sched;
+    sched->workers[i].deque = ws_deque_create(sizeof(_task), DEQUE_CAPACITY);
+    sched->workers[i].random = 2654435761u * (i + 1);
+  }
+  for (int i = 0; i < num_workers; i++)
+    pthread_create(&sched->workers[i].thread, NULL, _worker_main, &sched->workers[i]);
+
+  return sched;
+}
+
+/*
+Get the number of worker threads
+
+Inputs:
+  sched - pointer to an instance of the scheduler type
+
+Returns:
+  The number of worker threads
+
+*/
+int scheduler_workers(scheduler_p sched)
+{
+  return sched->num_workers;
+}
+
+/*
+Initialises an empty task group
+
+Inputs:
+  group - pointer to the task group to initialise
+
+Returns:
+  Nothing
+
+*/
+void task_group_init(task_group *group)
+{
+  atomic_init(&group->pending, 0);
+}
+
+/*
+Spawns a task. On a worker thread of this scheduler the task goes on the
+worker's own deque, otherwise it goes on the injection queue
+
+Inputs:
+  sched - pointer to an instance of the scheduler type
+  group - the group to add the task to
+  fn - the function to run
+  arg - the argument passed to fn
+
+Returns:
+  Nothing
+
+*/
+void scheduler_spawn(scheduler_p sched, task_group *group, void (*fn)(void *arg), void *arg)
+{
+  _task task = {fn, arg, group};
+  atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+
+  if (current_worker && current_worker->sched == sched)
+    ws_deque_push(current_worker->deque, &task);
+  else
+    blocking_queue_push(sched->injection, &task);
+}
+
+/*
+Waits for every task in a group to finish, running tasks meanwhile
+
+Inputs:
+  sched - pointer to an instance of the scheduler type
+  group - the task group to wait for
+
+Returns:
+  Nothing
+
+*/
+void scheduler_wait(scheduler_p sched, task_group *group)
+{
+  _worker_p self = (current_worker && current_worker->sched == sched) ? current_worker : NULL;
+  _task task;
+  while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0)
+  {
+    if (_find_task(sched, self, &task))
+      _run_task(&task);
+    else
+      sched_yield();
+  }
+}
+
+/*
+Stops the worker threads and frees the memory allocated to the scheduler
+
+Inputs:
+  sched - pointer to an instance of the scheduler type
+
+Returns:
+  Nothing
+
+*/
+void scheduler_delete(scheduler_p sched)
+{
+  if (sched)
+  {
+    atomic_store(&sched->stop, true);
+    blocking_queue_close(sched->injection);
+    for (int i = 0; i < sched->num_workers; i++)
+      pthread_join(sched->workers[i].thread, NULL);
+
+    for (int i = 0; i < sched->num_workers; i++)
+      ws_deque_delete(sched->workers[i].deque);
+    blocking_queue_delete(sched->injection);
+    free(sched->workers);
+    free(sched);
+  }
+}
+
+/*
+Internal function run by each worker thread.
+Runs tasks until the scheduler is stopped, sleeping on the injection
+queue after IDLE_SPINS fruitless searches
+
+Inputs:
+  arg - the worker (_worker_p)
+
+Returns:
+  NULL
+
+*/
+void *_worker_main(void *arg)
+{
+  _worker_p self = arg;
+  scheduler_p sched = self->sched;
+  current_worker = self;
+
+  _task task;
+  int idle = 0;
+  while (!atomic_load_explicit(&sched->stop, memory_order_relaxed))
+  {
+    if (_find_task(sched, self, &task))
+    {
+      _run_task(&task);
+      idle = 0;
+    }
+    else if (++idle < IDLE_SPINS)
+    {
+      sched_yield();
+    }
+    else if (blocking_queue_pop_timed(sched->injection, &task, IDLE_SLEEP_MS) == BLOCKING_QUEUE_OK)
+    {
+      _run_task(&task);
+      idle = 0;
+    }
+  }
+  return NULL;
+}
+
+/*
+Internal function to find a task to run: first from the worker's own
+deque (newest first), then from the injection queue, then by stealing
+(oldest first) from the other workers, starting at a random victim
+
+Inputs:
+  sched - pointer to an instance of the scheduler type
+  self - the worker on the calling thread (NULL if not a worker)
+  task - pointer to a task to store the task found
+
+Returns:
+  True if a task was found
+  False otherwise
+
+*/
+bool _find_task(scheduler_p sched, _worker_p self, _task *task)
+{
+  if (self && ws_deque_pop(self->deque, task))
+    return true;
+
+  if (blocking_queue_pop_timed(sched->injection, task, 0) == BLOCKING_QUEUE_OK)
+    return true;
+
+  uint32_t start = 0;
+  if (self)
+  {
+    self->random ^= self->random << 13;
+    self->random ^= self->random >> 17;
+    self->random ^= self->random << 5;
+    start = self->random;
+  }
+  for (int i = 0; i < sched->num_workers; i++)
+  {
+    _worker_p victim = &sched->workers[(start + i) % sched->num_workers];
+    if (victim == self)
+      continue;
+
+    ws_deque_status status;
+    do
+    {
+      status = ws_deque_steal(victim->deque, task);
+    } while (status == WS_DEQUE_ABORT);
+    if (status == WS_DEQUE_OK)
+      return true;
+  }
+  return false;
+}
+
+/*
+Internal function to run a task and mark it as finished in its group
+
+Inputs:
+  task - the task to run
+
+Returns:
+  Nothing
+
+*/
+void _run_task(_task *task)
+{
+  task->fn(task->arg);
+  atomic_fetch_sub_explicit(&task->group->pending, 1, memory_order_release);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file scheduler.h
+ * @brief Public function prototypes for the scheduler module
+ *
+ * Function prototypes required to use the scheduler module.
+ * The scheduler is a small work-stealing thread pool for fork/join
+ * style work. Each worker thread has its own ws_deque of tasks: tasks
+ * spawned by a worker go on its own deque, idle workers steal from the
+ * others, and tasks spawned by other threads go through a shared
+ * injection queue.
+ *
+ * A task_group counts the tasks spawned into it that have not yet
+ * finished; scheduler_wait runs tasks until the count reaches zero, so
+ * a task may spawn subtasks and wait for them without blocking a worker.
+ *
+ * Example usage:
+ * scheduler_p sched = scheduler_create(0);
+ * task_group group;
+ * task_group_init(&group);
+ * scheduler_spawn(sched, &group, my_task, &my_args);
+ * scheduler_wait(sched, &group);
+ * scheduler_delete(sched);
+ *
+ * @author ruairin
+ */
+
+#include <stdatomic.h>
+
+#ifndef SCHEDULER
+#define SCHEDULER
+
+/**
+ * @brief Data type represeting the scheduler
+ */
+typedef struct scheduler *scheduler_p;
+
+/**
+ * @brief A set of spawned tasks which can be waited on
+ */
+typedef struct task_group
+{
+  atomic_long pending; // tasks spawned but not yet finished
+} task_group;
+
+/**
+ * @brief create a scheduler and start its worker threads
+ *
+ * @param[in] num_workers The number of worker threads (0 for one per online CPU)
+ * @return A scheduler_p (i.e. pointer to the scheduler data type) to the created scheduler
+ */
+scheduler_p scheduler_create(int num_workers);
+
+/**
+ * @brief Get the number of worker threads
+ *
+ * @param[in] sched A pointer to an instance of the scheduler_p data type
+ * @return The number of worker threads
+ */
+int scheduler_workers(scheduler_p sched);
+
+/**
+ * @brief initialise an empty task group
+ *
+ * @param[in] group A pointer to the task group to initialise
+ * @return nothing
+ */
+void task_group_init(task_group *group);
+
+/**
+ * @brief spawn a task which calls fn(arg) on one of the worker threads
+ *
+ * May be called from any thread, including from inside a task.
+ *
+ * @param[in] sched A pointer to an instance of the scheduler_p data type
+ * @param[in] group The group to add the task to (must outlive the task)
+ * @param[in] fn The function to run
+ * @param[in] arg The argument passed to fn
+ * @return nothing
+ */
+void scheduler_spawn(scheduler_p sched, task_group *group, void (*fn)(void *arg), void *arg);
+
+/**
+ * @brief Wait until every task in a group has finished
+ *
+ * The calling thread runs pending tasks while it waits.
+ *
+ * @param[in] sched A pointer to an instance of the scheduler_p data type
+ * @param[in] group The task group to wait for
+ * @return nothing
+ */
+void scheduler_wait(scheduler_p sched, task_group *group);
+
+/**
+ * @brief Stop the worker threads and deallocate memory
+ *
+ * Every spawned task must have been waited for.
+ *
+ * @param[in] sched A pointer to an instance of the scheduler_p data type
+ * @return nothing
+ */
+void scheduler_delete(scheduler_p sched);
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * scheduler_p.h
+ *
+ * Private header file for scheduler module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdbool.h>
+#include "scheduler.h"
+
+#ifndef SCHEDULER_P
+#define SCHEDULER_P
+
+/**
+ * @brief Data type representing a task (the element type of the deques)
+ */
+typedef struct _task _task;
+
+/**
+ * @brief Data type representing a worker thread
+ */
+typedef struct _worker *_worker_p;
+
+void *_worker_main(void *arg);
+bool _find_task(scheduler_p sched, _worker_p self, _task *task);
+void _run_task(_task *task);
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * serialize.c
+ *
+ * Implementation of the binary file format used to save and load
+ * lists and queues
+ *
+ * A file is a _serial_header (magic, version, element size, item count
+ * and a checksum of the items) followed by the items as one raw block,
+ * in list/queue order. Lists and queues share the format, so a saved
+ * list can be loaded as a queue and vice versa. Integers are stored in
+ * the byte order of the machine, so files are not portable between
+ * machines of different endianness.
+ *
+ * Files are loaded by mapping them (privately, so changes are not written
+ * back), which lets a list adopt the items in place instead of copying them.
+ *
+ * @author ruairin
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "serialize_p.h"
+
+#define SERIAL_MAGIC "DSDATA\0\0"
+#define SERIAL_VERSION 1
+
+#define CHECKSUM_PRIME 0x100000001b3ULL
+
+/*
+Internal function to update a checksum with a block of bytes.
+The bytes are hashed a word at a time (FNV-1a on 64 bit words, with
+an extra shift so the high bits of each word reach the low bits).
+A checksum can be built up over several blocks, but every block
+except the last must be a multiple of 8 bytes
+
+Inputs:
+  hash - the checksum so far (CHECKSUM_SEED for the first block)
+  data - pointer to the bytes
+  bytes - the number of bytes
+
+Returns:
+  The updated checksum
+
+*/
+uint64_t _checksum(uint64_t hash, const void *data, size_t bytes)
+{
+  const char *p = data;
+  while (bytes >= sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    hash = (hash ^ word) * CHECKSUM_PRIME;
+    hash ^= hash >> 29;
+    p += sizeof(word);
+    bytes -= sizeof(word);
+  }
+  if (bytes > 0)
+  {
+    // The partial word is tagged with its length in the (otherwise zero) top byte
+    uint64_t word = 0;
+    memcpy(&word, p, bytes);
+    hash = (hash ^ word ^ ((uint64_t)bytes << 56)) * CHECKSUM_PRIME;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+/*
+Internal function to create a file to save items to.
+Space is left for the header, which is written by _serial_end
+once the items have been written (and the checksum is known)
+
+Inputs:
+  path - the path of the file (replaced if it exists)
+
+Returns:
+  The open file, positioned after the header, or NULL on error
+
+*/
+FILE *_serial_begin(const char *path)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+    return NULL;
+
+  if (fseek(file, SERIAL_HEADER_SIZE, SEEK_SET) != 0)
+  {
+    fclose(file);
+    return NULL;
+  }
+  return file;
+}
+
+/*
+Internal function to write the header of a file from _serial_begin
+and close it
+
+Inputs:
+  file - the file (with the items written)
+  element_size - the size of each item
+  count - the number of items
+  checksum - the checksum of the items
+
+Returns:
+  0 on success, -1 if the file could not be written
+
+*/
+int _serial_end(FILE *file, size_t element_size, uint64_t count, uint64_t checksum)
+{
+  _serial_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SERIAL_MAGIC, sizeof(header.magic));
+  header.version = SERIAL_VERSION;
+  header.header_size = SERIAL_HEADER_SIZE;
+  header.element_size = element_size;
+  header.count = count;
+  header.checksum = checksum;
+
+  bool ok = !ferror(file) &&
+            fseek(file, 0, SEEK_SET) == 0 &&
+            fwrite(&header, sizeof(header), 1, file) == 1;
+  if (fclose(file) != 0)
+    ok = false;
+  return ok ? 0 : -1;
+}
+
+/*
+Internal function to map a saved file and check it
+(the header matches element_size and the file length, and the checksum
+of the items is correct). The mapping is private and writable, so the
+items can be changed in place without changing the file
+
+Inputs:
+  path - the path of the file
+  element_size - the expected size of each item
+
+Outputs:
+  length - the length of the mapping
+  count - the number of items (which start SERIAL_HEADER_SIZE bytes in)
+
+Returns:
+  The mapping, or NULL if the file cannot be read or is not valid
+
+*/
+char *_serial_map(const char *path, size_t element_size, size_t *length, size_t *count)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < SERIAL_HEADER_SIZE)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  char *map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd); // the mapping keeps the file open
+  if (map == MAP_FAILED)
+    return NULL;
+
+  const _serial_header *header = (const _serial_header *)map;
+  size_t items = (size_t)st.st_size - SERIAL_HEADER_SIZE;
+  bool valid = memcmp(header->magic, SERIAL_MAGIC, sizeof(header->magic)) == 0 &&
+               header->version == SERIAL_VERSION &&
+               header->header_size == SERIAL_HEADER_SIZE &&
+               header->element_size == element_size &&
+               element_size > 0 &&
+               header->count == items / element_size &&
+               items % element_size == 0 &&
+               header->count <= INT32_MAX;
+  if (valid)
+  {
+    // Sequential access, for the checksum (and usually the caller)
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+    valid = _checksum(CHECKSUM_SEED, map + SERIAL_HEADER_SIZE, items) == header->checksum;
+    madvise(map, st.st_size, MADV_NORMAL);
+  }
+  if (!valid)
+  {
+    munmap(map, st.st_size);
+    return NULL;
+  }
+
+  *length = st.st_size;
+  *count = header->count;
+  return map;
+}
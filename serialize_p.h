@@ -0,0 +1,45 @@
+/**
+ * serialize_p.h
+ *
+ * Private header file for the binary file format
+ * shared by list_save/list_load and queue_save/queue_load (serialize.c)
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifndef SERIALIZE_P
+#define SERIALIZE_P
+
+// The items start after the header, so they are cache line aligned in a mapping
+#define SERIAL_HEADER_SIZE 64
+
+// The initial value of the checksum, passed to the first _checksum call
+#define CHECKSUM_SEED 0xcbf29ce484222325ULL
+
+/**
+ * @brief The header at the start of a saved list or queue
+ * (followed by count items of element_size bytes)
+ */
+typedef struct _serial_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t element_size;
+  uint64_t count;
+  uint64_t checksum; // of the items
+  char reserved[24];
+} _serial_header;
+
+uint64_t _checksum(uint64_t hash, const void *data, size_t bytes);
+FILE *_serial_begin(const char *path);
+int _serial_end(FILE *file, size_t element_size, uint64_t count, uint64_t checksum);
+char *_serial_map(const char *path, size_t element_size, size_t *length, size_t *count);
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * spsc_queue.c
+ *
+ * Implementation of functions for the spsc_queue module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "spsc_queue_p.h"
+
+/*
+The spsc queue is a bounded circular buffer with free-running head and
+tail indices. The slot for an index is (index & mask), and the queue
+holds (tail - head) items.
+
+Only the consumer writes head and only the producer writes tail.
+Each side also keeps a cached copy of the other side's index, so it
+only needs to read the other cache line when the queue looks
+full (producer) or empty (consumer).
+
+The release store of tail (after copying the value in) pairs with the
+consumer's acquire load, so the consumer never sees a slot before its
+value. Likewise for head, so the producer never overwrites a slot
+before the consumer has copied its value out.
+
+Data is a char because pointer arithmetic is used
+*/
+typedef struct spsc_queue
+{
+  // Read-only after creation
+  char *data;
+  size_t mask; // capacity - 1 (capacity is a power of two)
+  size_t element_size;
+
+  // Written by the consumer
+  alignas(CACHE_LINE_SIZE) atomic_size_t head;
+  size_t cached_tail;
+
+  // Written by the producer
+  alignas(CACHE_LINE_SIZE) atomic_size_t tail;
+  size_t cached_head;
+} *spsc_queue_p;
+
+/*
+Creates and initialises a new empty spsc queue using the spsc_queue_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the queue
+  capacity - the maximum number of items in the queue (rounded up to a power of two)
+
+Returns:
+  A spsc_queue_p (pointer to the newly created queue)
+
+Throws:
+  aborts if the capacity is not positive or if the memory allocations fail
+
+*/
+spsc_queue_p spsc_queue_create(size_t element_size, int capacity)
+{
+  assert(capacity > 0 && "Error: Queue capacity must be positive");
+
+  spsc_queue_p queue;
+
+  // aligned_alloc requires the size to be a multiple of the alignment,
+  // which sizeof(struct spsc_queue) is because of the alignas members
+  queue = (spsc_queue_p)aligned_alloc(CACHE_LINE_SIZE, sizeof(struct spsc_queue));
+  assert(queue != NULL && "Error in memory allocation");
+
+  size_t slots = _spsc_round_capacity(capacity);
+  queue->mask = slots - 1;
+  queue->element_size = element_size;
+  queue->data = malloc(slots * element_size);
+  assert(queue->data != NULL && "Error in memory allocation");
+
+  atomic_init(&queue->head, 0);
+  atomic_init(&queue->tail, 0);
+  queue->cached_head = 0;
+  queue->cached_tail = 0;
+
+  return queue;
+}
+
+/*
+Enqueue an item at the back/tail of the queue.
+Must only be called from the producer thread.
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+  value - pointer to a variable containing the value of the item to be enqueued
+
+Returns:
+  True if the item was enqueued, false if the queue is full
+
+*/
+bool spsc_queue_enqueue(spsc_queue_p queue, const void *value)
+{
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+  if (tail - queue->cached_head > queue->mask)
+  {
+    queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail - queue->cached_head > queue->mask)
+      return false;
+  }
+
+  memcpy(_spsc_slot(queue, tail), value, queue->element_size);
+  atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+/*
+Get the value of the item at the top/head of the queue.
+Must only be called from the consumer thread.
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+  out - pointer to a variable to store the value at the top of the queue
+
+Outputs:
+  out - the value at the top of the queue (unchanged if the queue is empty)
+
+Returns:
+  True if a value was copied to out, false if the queue is empty
+
+*/
+bool spsc_queue_peek(spsc_queue_p queue, void *out)
+{
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+  if (head == queue->cached_tail)
+  {
+    queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head == queue->cached_tail)
+      return false;
+  }
+
+  memcpy(out, _spsc_slot(queue, head), queue->element_size);
+  return true;
+}
+
+/*
+Dequeue the item at the head of the queue.
+Must only be called from the consumer thread.
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+  out - pointer to a variable to store the value of the dequeued item
+
+Outputs:
+  out - the value of the dequeued item (unchanged if the queue is empty)
+
+Returns:
+  True if an item was dequeued, false if the queue is empty
+
+*/
+bool spsc_queue_dequeue(spsc_queue_p queue, void *out)
+{
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+  if (head == queue->cached_tail)
+  {
+    queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head == queue->cached_tail)
+      return false;
+  }
+
+  memcpy(out, _spsc_slot(queue, head), queue->element_size);
+  atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+  return true;
+}
+
+/*
+Get the number of items currently in the queue
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+
+Returns:
+  The number of items in the queue
+
+*/
+int spsc_queue_size(spsc_queue_p queue)
+{
+  size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+  return (int)(tail - head);
+}
+
+/*
+Frees the memory allocated to queue
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+
+Returns:
+  Nothing
+
+*/
+void spsc_queue_delete(spsc_queue_p queue)
+{
+  if (queue)
+  {
+    if (queue->data)
+      free(queue->data);
+    free(queue);
+  }
+}
+
+/*
+Internal function to round the requested capacity up to a power of two
+so that buffer slots can be found by masking rather than division
+
+Inputs:
+  capacity - the requested capacity
+
+Returns:
+  The smallest power of two >= capacity
+
+*/
+size_t _spsc_round_capacity(int capacity)
+{
+  size_t slots = 1;
+  while (slots < (size_t)capacity)
+    slots <<= 1;
+  return slots;
+}
+
+/*
+Internal function to perform pointer arithmetic
+
+Inputs:
+  queue - pointer to an instance of the spsc queue type
+  index - a free-running head or tail index
+
+Returns:
+  Pointer to the buffer slot for index
+
+*/
+void *_spsc_slot(spsc_queue_p queue, size_t index)
+{
+  return queue->data + (index & queue->mask) * queue->element_size;
+}
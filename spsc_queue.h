@@ -0,0 +1,92 @@
+/**
+ * @file spsc_queue.h
+ * @brief Public function prototypes for the spsc_queue module
+ *
+ * Function prototypes required to use the spsc_queue module.
+ * The spsc queue is a bounded, lock-free queue for handing items from
+ * exactly one producer thread to exactly one consumer thread.
+ * As for the queue module, values are copied in and out of the queue
+ * (element_size bytes at a time).
+ *
+ * Thread safety:
+ * spsc_queue_enqueue may only be called from the (single) producer thread.
+ * spsc_queue_peek and spsc_queue_dequeue may only be called from the
+ * (single) consumer thread. spsc_queue_create and spsc_queue_delete must
+ * not run concurrently with any other call on the same queue.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifndef SPSC_QUEUE
+#define SPSC_QUEUE
+
+/**
+ * @brief Data type represeting the spsc queue
+ */
+typedef struct spsc_queue *spsc_queue_p;
+
+/**
+ * @brief create and initialise a new spsc queue
+ *
+ * The initial size of the queue is zero.
+ * Example usage to create a queue of up to 1024 ints:
+ * spsc_queue_p my_queue;
+ * my_queue = spsc_queue_create(sizeof(int), 1024);
+ *
+ * @param[in] element_size The size of the data type to be stored in the queue
+ * @param[in] capacity The maximum number of items in the queue
+ *                     (rounded up to a power of two)
+ * @return A spsc_queue_p (i.e. pointer to the queue data type) to the created queue
+ */
+spsc_queue_p spsc_queue_create(size_t element_size, int capacity);
+
+/**
+ * @brief add a new value to the back/tail of the queue (producer only)
+ *
+ * @param[in] queue A pointer to an instance of the spsc_queue_p data type
+ * @param[in] value pointer to a variable storing the value to be added to the queue
+ * @return true if the value was added, false if the queue is full
+ */
+bool spsc_queue_enqueue(spsc_queue_p queue, const void *value);
+
+/**
+ * @brief get the value at the top/head of the queue (consumer only)
+ *
+ * @param[in] queue A pointer to an instance of the spsc_queue_p data type
+ * @param[inout] out pointer to a variable storing the value at the top of the queue
+ * @return true if a value was copied to out, false if the queue is empty
+ */
+bool spsc_queue_peek(spsc_queue_p queue, void *out);
+
+/**
+ * @brief Remove the item at the top/head of the queue (consumer only)
+ *
+ * @param[in] queue A pointer to an instance of the spsc_queue_p data type
+ * @param[inout] out pointer to a variable containing the value of the item that was dequeued
+ * @return true if an item was dequeued, false if the queue is empty
+ */
+bool spsc_queue_dequeue(spsc_queue_p queue, void *out);
+
+/**
+ * @brief Get the number of items currently in the queue
+ *
+ * When called while the other thread is active, the result is a snapshot
+ * which may already be out of date.
+ *
+ * @param[in] queue A pointer to an instance of the spsc_queue_p data type
+ * @return The number of items in the queue
+ */
+int spsc_queue_size(spsc_queue_p queue);
+
+/**
+ * @brief Delete the queue and deallocate memory
+ *
+ * @param[in] queue A pointer to an instance of the spsc_queue_p data type
+ * @return nothing
+ */
+void spsc_queue_delete(spsc_queue_p queue);
+
+#endif
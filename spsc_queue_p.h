@@ -0,0 +1,24 @@
+/**
+ * spsc_queue_p.h
+ *
+ * Private header file for spsc_queue module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdlib.h>
+#include "spsc_queue.h"
+
+#ifndef SPSC_QUEUE_P
+#define SPSC_QUEUE_P
+
+// Assumed size of a cache line.
+// head and tail are placed on separate cache lines so that the
+// producer and consumer never write to the same line
+#define CACHE_LINE_SIZE 64
+
+size_t _spsc_round_capacity(int capacity);
+void *_spsc_slot(spsc_queue_p queue, size_t index);
+
+#endif
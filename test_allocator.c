@@ -0,0 +1,102 @@
+/**
+ * Basic tests for the allocator module and its use by list and queue
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include "allocator.h"
+#include "array_list.h"
+#include "queue.h"
+
+void test_allocator(void)
+{
+  printf("\n================================");
+  printf("\n======== Allocator Test ========");
+  printf("\n================================\n\n");
+
+  printf("--- Arena ---\n");
+  arena_p arena = arena_create(1024);
+  allocator alloc = arena_allocator(arena);
+
+  char *a = alloc.alloc(alloc.ctx, 3);
+  char *b = alloc.alloc(alloc.ctx, 5);
+  assert((uintptr_t)b % _Alignof(max_align_t) == 0 && "Error: Arena allocation not aligned");
+  memcpy(b, "abcd", 5);
+  char *b_grown = alloc.realloc(alloc.ctx, b, 5, 100);
+  assert(b_grown == b && "Error: Last arena allocation not grown in place");
+  char *a_grown = alloc.realloc(alloc.ctx, a, 3, 100);
+  assert(a_grown != a && "Error: Arena allocation grown over the next allocation");
+  char *big = alloc.alloc(alloc.ctx, 4096);
+  memset(big, 1, 4096);
+  char *c = alloc.alloc(alloc.ctx, 16);
+  assert(c > b && c < b + 1024 && "Error: Small allocation did not continue in the current block");
+  printf("Arena allocations - OK\n");
+
+  printf("List and queue built in the arena\n");
+  list_p my_list = list_create_ex(sizeof(int), &alloc);
+  queue_p my_queue = queue_create_ex(sizeof(int), &alloc);
+  for (int i = 0; i < 1000; i++)
+  {
+    list_append(my_list, &i);
+    queue_enqueue(my_queue, &i);
+  }
+  int value;
+  for (int i = 0; i < 1000; i++)
+  {
+    list_get(my_list, i, &value);
+    assert(value == i && "Error: Incorrect list value in arena");
+    queue_dequeue(my_queue, &value);
+    assert(value == i && "Error: Incorrect queue value in arena");
+  }
+  arena_reset(arena);
+  printf("Arena reset - OK\n");
+
+  my_list = list_create_ex(sizeof(int), &alloc);
+  list_append(my_list, &value);
+  list_delete(my_list);
+  arena_delete(arena);
+  printf("Arena deleted\n");
+
+  printf("\n--- Pool ---\n");
+  pool_p pool = pool_create(queue_node_size(sizeof(int)), 8);
+  alloc = pool_allocator(pool);
+
+  void *first = alloc.alloc(alloc.ctx, queue_node_size(sizeof(int)));
+  alloc.free(alloc.ctx, first, queue_node_size(sizeof(int)));
+  void *again = alloc.alloc(alloc.ctx, queue_node_size(sizeof(int)));
+  assert(again == first && "Error: Freed pool object not reused");
+  alloc.free(alloc.ctx, again, queue_node_size(sizeof(int)));
+  printf("Pool reuse - OK\n");
+
+  printf("Queue elements from the pool\n");
+  queue_p pooled = queue_create_ex(sizeof(int), &alloc);
+  for (int round = 0; round < 3; round++)
+  {
+    for (int i = 0; i < 100; i++)
+      queue_enqueue(pooled, &i);
+    for (int i = 0; i < 100; i++)
+    {
+      queue_dequeue(pooled, &value);
+      assert(value == i && "Error: Incorrect queue value from pool");
+    }
+  }
+  for (int i = 0; i < 10; i++)
+    queue_enqueue(pooled, &i);
+  queue_delete(pooled);
+  printf("Pooled queue - OK\n");
+
+  printf("List grown beyond the pool object size\n");
+  list_p pooled_list = list_create_ex(sizeof(int), &alloc);
+  for (int i = 0; i < 100; i++)
+    list_append(pooled_list, &i);
+  list_get(pooled_list, 99, &value);
+  assert(value == 99 && "Error: expected 99 at last index");
+  list_delete(pooled_list);
+
+  pool_delete(pool);
+  printf("Pool deleted\n");
+}
@@ -0,0 +1,7 @@
+
+#ifndef TEST_ALLOCATOR
+#define TEST_ALLOCATOR
+
+void test_allocator(void);
+
+#endif
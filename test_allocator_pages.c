@@ -0,0 +1,83 @@
+/**
+ * Tests for the page allocator, with each of its options.
+ * Huge pages and NUMA policies are hints, so the tests check that
+ * lists built with them work whether or not the system provides them.
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "allocator.h"
+#include "array_list.h"
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static const int test_flags[] = {
+    PAGES_DEFAULT,
+    PAGES_THP,
+    PAGES_HUGETLB,
+    PAGES_THP | PAGES_NUMA_BIND,
+    PAGES_THP | PAGES_NUMA_INTERLEAVE,
+};
+#define NUM_FLAGS (int)(sizeof(test_flags) / sizeof(test_flags[0]))
+
+void test_allocator_pages(void)
+{
+  printf("\n=====================================");
+  printf("\n======== Page Allocator Test ========");
+  printf("\n=====================================\n\n");
+
+  printf("Allocate, grow and shrink\n");
+  for (int f = 0; f < NUM_FLAGS; f++)
+  {
+    pages_p pages = pages_create(test_flags[f], 0x1);
+    allocator alloc = pages_allocator(pages);
+
+    // Small allocations come from the heap
+    char *small = alloc.alloc(alloc.ctx, 100);
+    memset(small, 1, 100);
+    small = alloc.realloc(alloc.ctx, small, 100, 200);
+    assert(small[99] == 1 && "Error: Small allocation not kept by realloc");
+
+    // Grow from the heap into a mapping, then grow and shrink the mapping
+    small = alloc.realloc(alloc.ctx, small, 200, 1 << 20);
+    assert(small[0] == 1 && "Error: Small allocation not copied to a mapping");
+    if (test_flags[f] & PAGES_THP)
+    {
+      assert((uintptr_t)small % HUGE_PAGE_SIZE == 0 && "Error: Mapping not aligned on a huge page");
+    }
+    memset(small, 2, 1 << 20);
+    char *big = alloc.realloc(alloc.ctx, small, 1 << 20, 5 << 20);
+    assert(big[(1 << 20) - 1] == 2 && "Error: Mapping contents not kept when grown");
+    memset(big, 3, 5 << 20);
+    big = alloc.realloc(alloc.ctx, big, 5 << 20, 100000);
+    assert(big[99999] == 3 && "Error: Mapping contents not kept when shrunk");
+    big = alloc.realloc(alloc.ctx, big, 100000, 1000);
+    assert(big[999] == 3 && "Error: Mapping contents not copied to the heap");
+    alloc.free(alloc.ctx, big, 1000);
+    pages_delete(pages);
+  }
+  printf("Allocate, grow and shrink - OK\n");
+
+  printf("List with each option\n");
+  for (int f = 0; f < NUM_FLAGS; f++)
+  {
+    pages_p pages = pages_create(test_flags[f], 0x1);
+    allocator alloc = pages_allocator(pages);
+    list_p list = list_create_ex(sizeof(long), &alloc);
+    for (long i = 0; i < 1000000; i++)
+      list_append(list, &i);
+    for (long i = 0; i < 1000000; i += 999)
+    {
+      assert(*(const long *)list_at(list, (int)i) == i && "Error: Incorrect list value");
+    }
+    while (list_size(list) > 10)
+      list_remove(list, list_size(list) - 1);
+    assert(*(const long *)list_at(list, 9) == 9 && "Error: Incorrect value after shrinking");
+    list_delete(list);
+    pages_delete(pages);
+  }
+  printf("List with each option - OK\n");
+}
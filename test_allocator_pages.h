@@ -0,0 +1,6 @@
+#ifndef TEST_ALLOCATOR_PAGES
+#define TEST_ALLOCATOR_PAGES
+
+void test_allocator_pages(void);
+
+#endif
@@ -11,6 +11,12 @@
 void print_list(list_p list, int start, int end);
 void strcat_dynamic(char *dest, char *src, int *dest_len);
 void grow_str(char *str, int *current_length, int required_length);
+void test_list_bulk_insert(void);
+void test_list_capacity(void);
+void test_list_views(void);
+void test_list_stats(void);
+void test_list_remove_bulk(void);
+void test_list_swap_remove(void);
 
 #define TYPE int
 #define PRINT_TYPE "%d"
@@ -146,9 +152,66 @@ int test_array_list(void)
   // list_get(my_list, -1);
 
   list_delete(my_list);
+
+  test_list_bulk_insert();
+  test_list_capacity();
+  test_list_views();
+  test_list_stats();
+  test_list_remove_bulk();
+  test_list_swap_remove();
   return 0;
 }
 
+/**
+ * Tests for list_append_n and list_insert_n
+ */
+void test_list_bulk_insert(void)
+{
+  printf("\n--- Append/Insert n ---\n");
+  list_p my_list = list_create(sizeof(TYPE));
+  TYPE values[100];
+  TYPE value;
+
+  for (int i = 0; i < 100; i++)
+    values[i] = i;
+
+  printf("Append 100 items in one call\n");
+  list_append_n(my_list, values, 100);
+  assert(list_size(my_list) == 100 && "Error: Incorrect list size after list_append_n");
+  for (int i = 0; i < 100; i++)
+  {
+    list_get(my_list, i, &value);
+    assert(value == i && "Error: Incorrect value after list_append_n");
+  }
+
+  printf("Insert 3 items at Index 0 and 3 items at Index 50\n");
+  TYPE front[3] = {-1, -2, -3};
+  list_insert_n(my_list, front, 3, 0);
+  list_insert_n(my_list, front, 3, 50);
+  assert(list_size(my_list) == 106 && "Error: Incorrect list size after list_insert_n");
+  list_get(my_list, 0, &value);
+  assert(value == -1 && "Error: expected -1 at index 0");
+  list_get(my_list, 2, &value);
+  assert(value == -3 && "Error: expected -3 at index 2");
+  list_get(my_list, 3, &value);
+  assert(value == 0 && "Error: expected 0 at index 3");
+  list_get(my_list, 49, &value);
+  assert(value == 46 && "Error: expected 46 at index 49");
+  list_get(my_list, 50, &value);
+  assert(value == -1 && "Error: expected -1 at index 50");
+  list_get(my_list, 53, &value);
+  assert(value == 47 && "Error: expected 47 at index 53");
+  list_get(my_list, 105, &value);
+  assert(value == 99 && "Error: expected 99 at last index");
+
+  printf("Insert 0 items at End of List\n");
+  list_insert_n(my_list, front, 0, list_size(my_list));
+  assert(list_size(my_list) == 106 && "Error: Incorrect list size after inserting 0 items");
+  printf("Append/Insert n test - OK\n");
+
+  list_delete(my_list);
+}
+
 /**
  * Print list contents
  *
@@ -266,3 +329,311 @@ void grow_str(char *str, int *current_length, int required_length)
   // Recursively double the length until there's sufficient capacity
   grow_str(str, current_length, required_length);
 }
+
+/**
+ * Tests for list_create_with_capacity, list_reserve, list_shrink_to_fit
+ * and the growth/shrink policies
+ */
+void test_list_capacity(void)
+{
+  printf("\n--- Capacity ---\n");
+  list_p my_list = list_create_with_capacity(sizeof(TYPE), 100);
+  TYPE value;
+
+  printf("Append 100 items to a list created with capacity 100\n");
+  for (int i = 0; i < 100; i++)
+    list_append(my_list, &i);
+  assert(list_capacity(my_list) == 100 && "Error: List grew before its capacity was reached");
+
+  printf("Reserve capacity for 1000 items\n");
+  list_reserve(my_list, 1000);
+  assert(list_capacity(my_list) == 1000 && "Error: Incorrect capacity after list_reserve");
+  list_reserve(my_list, 10);
+  assert(list_capacity(my_list) == 1000 && "Error: list_reserve reduced the capacity");
+
+  printf("Shrink to fit\n");
+  list_shrink_to_fit(my_list);
+  assert(list_capacity(my_list) == 100 && "Error: Incorrect capacity after list_shrink_to_fit");
+  list_get(my_list, 99, &value);
+  assert(value == 99 && "Error: expected 99 at last index");
+
+  printf("Grow in chunks of 10 items\n");
+  list_set_growth_policy(my_list, 0, 10);
+  list_append(my_list, &value);
+  assert(list_capacity(my_list) == 110 && "Error: Incorrect capacity after chunked growth");
+  for (int i = 0; i < 15; i++)
+    list_append(my_list, &i);
+  assert(list_capacity(my_list) == 120 && "Error: Incorrect capacity after chunked growth");
+
+  printf("Disable shrinking and remove most items\n");
+  list_set_shrink_policy(my_list, 0, 0.5);
+  while (list_size(my_list) > 1)
+    list_remove(my_list, list_size(my_list) - 1);
+  assert(list_capacity(my_list) == 120 && "Error: List shrank with shrinking disabled");
+
+  printf("Shrink to 3/4 of the capacity at 1/2 full\n");
+  list_set_growth_policy(my_list, 2, 0);
+  list_set_shrink_policy(my_list, 0.5, 0.75);
+  for (int i = 0; i < 99; i++)
+    list_append(my_list, &i);
+  // 100 items in 120: removing down to 60 items triggers one shrink to 90
+  while (list_size(my_list) > 59)
+    list_remove(my_list, 0);
+  assert(list_capacity(my_list) == 90 && "Error: Incorrect capacity after shrinking");
+  printf("Capacity test - OK\n");
+
+  list_delete(my_list);
+}
+
+/**
+ * Tests for list_at and list_data_span
+ */
+void test_list_views(void)
+{
+  printf("\n--- At/Span ---\n");
+  list_p my_list = list_create(sizeof(TYPE));
+  const void *data;
+  int length;
+
+  list_data_span(my_list, &data, &length);
+  assert(length == 0 && "Error: Span of empty list is not empty");
+
+  for (int i = 0; i < 100; i++)
+  {
+    TYPE value = i * 2;
+    list_append(my_list, &value);
+  }
+
+  printf("Read items through list_at\n");
+  assert(*(const TYPE *)list_at(my_list, 0) == 0 && "Error: expected 0 at index 0");
+  assert(*(const TYPE *)list_at(my_list, 99) == 198 && "Error: expected 198 at index 99");
+
+  printf("Scan items through list_data_span\n");
+  list_data_span(my_list, &data, &length);
+  assert(length == 100 && "Error: Incorrect span length");
+  const TYPE *items = data;
+  for (int i = 0; i < length; i++)
+    assert(items[i] == i * 2 && "Error: Incorrect value in span");
+
+  printf("list_set is visible through an existing view\n");
+  TYPE value = -1;
+  list_set(my_list, &value, 50);
+  assert(items[50] == -1 && "Error: expected -1 at index 50 of span");
+  printf("At/Span test - OK\n");
+
+  list_delete(my_list);
+}
+
+// Resize trace which records each capacity change
+struct resize_log
+{
+  int count;
+  int old_capacity[8];
+  int new_capacity[8];
+};
+
+static void log_resize(list_p list, int old_capacity, int new_capacity, void *ctx)
+{
+  struct resize_log *log = ctx;
+  (void)list;
+  if (log->count < 8)
+  {
+    log->old_capacity[log->count] = old_capacity;
+    log->new_capacity[log->count] = new_capacity;
+  }
+  log->count++;
+}
+
+/**
+ * Tests for list_stats (kept only when built with STATS=1) and resize tracing
+ */
+void test_list_stats(void)
+{
+  printf("\n--- Statistics and resize trace ---\n");
+  list_p my_list = list_create_with_capacity(sizeof(TYPE), 16);
+  struct resize_log log = {0};
+  list_set_resize_trace(my_list, log_resize, &log);
+
+  // 100 appends grow the list 16 -> 32 -> 64 -> 128, then 4 inserts at the front
+  for (int i = 0; i < 100; i++)
+    list_append(my_list, &i);
+  for (int i = 0; i < 4; i++)
+    list_insert(my_list, &i, 0);
+  // Removing from the front down to 31 items shrinks the list 128 -> 64
+  // (on the remove at 32 items, a quarter of the capacity)
+  while (list_size(my_list) > 31)
+    list_remove(my_list, 0);
+
+  assert(log.count == 4 && "Error: Incorrect number of resizes traced");
+  assert(log.old_capacity[0] == 16 && log.new_capacity[0] == 32 &&
+         log.old_capacity[2] == 64 && log.new_capacity[2] == 128 &&
+         log.old_capacity[3] == 128 && log.new_capacity[3] == 64 && "Error: Incorrect resizes traced");
+
+  list_statistics stats;
+  if (list_stats(my_list, &stats))
+  {
+    assert(stats.grows == 3 && stats.shrinks == 1 && "Error: Incorrect grows/shrinks");
+    assert(stats.peak_capacity == 128 && "Error: Incorrect peak capacity");
+    assert(stats.inserts == 104 && stats.removes == 73 && "Error: Incorrect inserts/removes");
+    // Each front insert shifts 100..103 items; each front remove shifts the remaining items
+    long long shift = 0;
+    for (int size = 100; size < 104; size++)
+      shift += size;
+    for (int size = 103; size >= 31; size--)
+      shift += size;
+    assert(stats.shift_bytes == shift * (long long)sizeof(TYPE) && "Error: Incorrect shift bytes");
+    assert(stats.bytes_copied >= 0 && "Error: Incorrect bytes copied");
+    printf("Statistics - OK\n");
+  }
+  else
+  {
+    assert(stats.grows == 0 && stats.inserts == 0 && "Error: Statistics without DS_STATS");
+    printf("Statistics not kept (build with STATS=1)\n");
+  }
+
+  list_set_resize_trace(my_list, NULL, NULL);
+  list_shrink_to_fit(my_list);
+  assert(log.count == 4 && "Error: Resize traced after tracing stopped");
+  printf("Resize trace - OK\n");
+
+  list_delete(my_list);
+}
+
+static bool is_even(const void *value, void *ctx)
+{
+  int *calls = ctx;
+  (*calls)++;
+  return *(const TYPE *)value % 2 == 0;
+}
+
+static bool is_less_than(const void *value, void *ctx)
+{
+  return *(const TYPE *)value < *(const TYPE *)ctx;
+}
+
+/**
+ * Tests for list_remove_if, list_retain and list_remove_range
+ */
+void test_list_remove_bulk(void)
+{
+  printf("\n--- Bulk remove ---\n");
+  list_p my_list = list_create(sizeof(TYPE));
+  for (int i = 0; i < 1000; i++)
+    list_append(my_list, &i);
+
+  // 1000 items in a capacity of 1024: removing 500 leaves it above a quarter full
+  int calls = 0;
+  struct resize_log log = {0};
+  list_set_resize_trace(my_list, log_resize, &log);
+  assert(list_remove_if(my_list, is_even, &calls) == 500 && "Error: Incorrect number removed");
+  assert(calls == 1000 && "Error: Predicate not called once per item");
+  assert(list_size(my_list) == 500 && list_capacity(my_list) == 1024 && log.count == 0 &&
+         "Error: Incorrect size or capacity after list_remove_if");
+  for (int i = 0; i < 500; i++)
+    assert(*(const TYPE *)list_at(my_list, i) == 2 * i + 1 && "Error: Incorrect item after list_remove_if");
+  calls = 0;
+  assert(list_remove_if(my_list, is_even, &calls) == 0 && calls == 500 && "Error: Nothing should be removed");
+  printf("list_remove_if - OK\n");
+
+  // Keeping the 50 items below 100 shrinks 1024 -> 512 -> 256 -> 128 in one resize
+  TYPE limit = 100;
+  assert(list_retain(my_list, is_less_than, &limit) == 450 && "Error: Incorrect number removed");
+  assert(list_size(my_list) == 50 && "Error: Incorrect size after list_retain");
+  assert(log.count == 1 && log.old_capacity[0] == 1024 && log.new_capacity[0] == 128 &&
+         "Error: Capacity should be shrunk once");
+  for (int i = 0; i < 50; i++)
+    assert(*(const TYPE *)list_at(my_list, i) == 2 * i + 1 && "Error: Incorrect item after list_retain");
+  printf("list_retain - OK\n");
+
+  // Remove items 10..19 (values 21..39), then an empty range, then the rest
+  list_remove_range(my_list, 10, 20);
+  assert(list_size(my_list) == 40 && "Error: Incorrect size after list_remove_range");
+  assert(*(const TYPE *)list_at(my_list, 9) == 19 && *(const TYPE *)list_at(my_list, 10) == 41 &&
+         *(const TYPE *)list_at(my_list, 39) == 99 && "Error: Incorrect items after list_remove_range");
+  list_remove_range(my_list, 5, 5);
+  assert(list_size(my_list) == 40 && "Error: Empty range should remove nothing");
+  list_remove_range(my_list, 0, list_size(my_list));
+  assert(list_size(my_list) == 0 && list_capacity(my_list) == 16 && "Error: Whole range not removed");
+  printf("list_remove_range - OK\n");
+
+  // With shrinking disabled, bulk removal keeps the capacity
+  for (int i = 0; i < 1000; i++)
+    list_append(my_list, &i);
+  list_set_shrink_policy(my_list, 0, 0.5);
+  calls = 0;
+  assert(list_remove_if(my_list, is_even, &calls) == 500 && "Error: Incorrect number removed");
+  limit = 0;
+  assert(list_retain(my_list, is_less_than, &limit) == 500 && "Error: Incorrect number removed");
+  assert(list_capacity(my_list) == 1024 && "Error: Capacity shrunk with shrinking disabled");
+  for (int i = 0; i < 1000; i++)
+    list_append(my_list, &i);
+  list_remove_range(my_list, 0, 1000);
+  assert(list_size(my_list) == 0 && list_capacity(my_list) == 1024 &&
+         "Error: Capacity shrunk with shrinking disabled");
+  printf("Bulk remove with shrinking disabled - OK\n");
+
+  // Clearing a large list shrinks it to the initial capacity in one resize
+  list_p large = list_create(sizeof(TYPE));
+  for (int i = 0; i < 1000000; i++)
+    list_append(large, &i);
+  assert(list_capacity(large) == 1048576 && "Error: Incorrect capacity of large list");
+  struct resize_log large_log = {0};
+  list_set_resize_trace(large, log_resize, &large_log);
+  list_remove_range(large, 0, list_size(large));
+  assert(list_size(large) == 0 && list_capacity(large) == 16 && "Error: Cleared list not shrunk");
+  assert(large_log.count == 1 && large_log.old_capacity[0] == 1048576 && "Error: Capacity should be shrunk once");
+  list_delete(large);
+  printf("Clear large list - OK\n");
+
+  // These fail on out of bounds assertions
+  // list_remove_range(my_list, 0, 1);
+  // list_remove_range(my_list, -1, 0);
+
+  list_set_resize_trace(my_list, NULL, NULL);
+  list_delete(my_list);
+}
+
+/**
+ * Tests for list_swap_remove and unordered lists
+ */
+void test_list_swap_remove(void)
+{
+  printf("\n--- Swap remove and unordered lists ---\n");
+  list_p my_list = list_create(sizeof(TYPE));
+  for (int i = 0; i < 5; i++)
+    list_append(my_list, &i);
+
+  // 0 1 2 3 4 -> 0 4 2 3 -> 0 4 2
+  list_swap_remove(my_list, 1);
+  list_swap_remove(my_list, 3);
+  assert(list_size(my_list) == 3 && "Error: Incorrect size after list_swap_remove");
+  assert(*(const TYPE *)list_at(my_list, 0) == 0 && *(const TYPE *)list_at(my_list, 1) == 4 &&
+         *(const TYPE *)list_at(my_list, 2) == 2 && "Error: Incorrect items after list_swap_remove");
+  list_delete(my_list);
+  printf("list_swap_remove - OK\n");
+
+  // list_remove on an unordered list swaps, and shrinks as for an ordered list
+  list_p ordered = list_create(sizeof(TYPE));
+  my_list = list_create_unordered(sizeof(TYPE));
+  for (int i = 0; i < 100; i++)
+  {
+    list_append(ordered, &i);
+    list_append(my_list, &i);
+  }
+  list_remove(my_list, 0);
+  assert(*(const TYPE *)list_at(my_list, 0) == 99 && *(const TYPE *)list_at(my_list, 1) == 1 &&
+         "Error: list_remove on an unordered list should move the last item");
+  list_remove(ordered, 0);
+
+  while (list_size(my_list) > 20)
+  {
+    list_remove(my_list, list_size(my_list) / 3);
+    list_remove(ordered, list_size(ordered) / 3);
+    assert(list_capacity(my_list) == list_capacity(ordered) && "Error: Shrink policy differs for unordered list");
+  }
+  assert(list_capacity(my_list) < 128 && "Error: Unordered list did not shrink");
+  printf("Unordered list_remove - OK\n");
+
+  list_delete(ordered);
+  list_delete(my_list);
+}
@@ -0,0 +1,93 @@
+/**
+ * Tests for saving and loading lists (list_save/list_load),
+ * including loading a saved list as a queue and rejecting damaged files.
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include "array_list.h"
+#include "queue.h"
+
+#define TEST_PATH "/tmp/test_array_list_io.dsd"
+
+void test_array_list_io(void)
+{
+  printf("\n====================================");
+  printf("\n======== Array List IO Test ========");
+  printf("\n====================================\n\n");
+
+  printf("Save and load\n");
+  list_p list = list_create(sizeof(int));
+  assert(list_save(list, TEST_PATH) == 0 && "Error: Cannot save empty list");
+  list_p loaded = list_load(TEST_PATH, sizeof(int));
+  assert(loaded != NULL && list_size(loaded) == 0 && "Error: Incorrect empty list after load");
+  list_delete(loaded);
+
+  // An odd number of ints, so the checksum ends with a partial word
+  int n = 10001;
+  for (int i = 0; i < n; i++)
+    list_append(list, &i);
+  assert(list_save(list, TEST_PATH) == 0 && "Error: Cannot save list");
+
+  loaded = list_load(TEST_PATH, sizeof(int));
+  assert(loaded != NULL && list_size(loaded) == n && "Error: Incorrect list size after load");
+  for (int i = 0; i < n; i++)
+  {
+    assert(*(const int *)list_at(loaded, i) == i && "Error: Incorrect value after load");
+  }
+
+  // Changes are made in place, then the list moves to the heap when it grows
+  int value = -5;
+  list_set(loaded, &value, 0);
+  list_append(loaded, &n);
+  assert(list_size(loaded) == n + 1 && "Error: Incorrect size after append");
+  assert(*(const int *)list_at(loaded, 0) == -5 && *(const int *)list_at(loaded, n) == n &&
+         "Error: Incorrect values after append");
+  for (int i = 1; i < n; i++)
+  {
+    assert(*(const int *)list_at(loaded, i) == i && "Error: Incorrect value after append");
+  }
+  list_delete(loaded);
+
+  // ... and are not written back to the file
+  loaded = list_load(TEST_PATH, sizeof(int));
+  assert(loaded != NULL && list_size(loaded) == n && *(const int *)list_at(loaded, 0) == 0 &&
+         "Error: Changes written back to the file");
+  list_delete(loaded);
+  printf("Save and load - OK\n");
+
+  printf("Load as a queue\n");
+  queue_p queue = queue_load(TEST_PATH, sizeof(int));
+  assert(queue != NULL && queue_size(queue) == n && "Error: Incorrect queue size after load");
+  for (int i = 0; i < n; i++)
+  {
+    queue_dequeue(queue, &value);
+    assert(value == i && "Error: Incorrect queue value after load");
+  }
+  queue_delete(queue);
+  printf("Load as a queue - OK\n");
+
+  printf("Invalid files\n");
+  assert(list_load(TEST_PATH, sizeof(short)) == NULL && "Error: Wrong element size accepted");
+  assert(list_load("/tmp/no_such_list.dsd", sizeof(int)) == NULL && "Error: Missing file accepted");
+
+  // Damage one item
+  FILE *file = fopen(TEST_PATH, "r+b");
+  assert(file != NULL && "Error: Cannot open test file");
+  fseek(file, -7, SEEK_END);
+  fputc(0x55, file);
+  fclose(file);
+  assert(list_load(TEST_PATH, sizeof(int)) == NULL && "Error: Damaged file accepted");
+  assert(queue_load(TEST_PATH, sizeof(int)) == NULL && "Error: Damaged file accepted");
+
+  // Cut the file short
+  assert(truncate(TEST_PATH, 100) == 0 && "Error: Cannot truncate test file");
+  assert(list_load(TEST_PATH, sizeof(int)) == NULL && "Error: Short file accepted");
+  assert(list_save(list, "/tmp/no_such_dir/list.dsd") == -1 && "Error: Save to a missing directory");
+
+  list_delete(list);
+  unlink(TEST_PATH);
+  printf("Invalid files - OK\n");
+}
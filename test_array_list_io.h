@@ -0,0 +1,6 @@
+#ifndef TEST_ARRAY_LIST_IO
+#define TEST_ARRAY_LIST_IO
+
+void test_array_list_io(void);
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * Tests for the memory-mapped (file-backed) array_list functions.
+ * Lists are created in /tmp and removed at the end of the test.
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include "array_list.h"
+
+#define TEST_PATH "/tmp/test_array_list_mapped.dsl"
+
+void test_array_list_mapped(void)
+{
+  printf("\n========================================");
+  printf("\n======== Array List Mapped Test ========");
+  printf("\n========================================\n\n");
+
+  printf("Create, append and reopen\n");
+  unlink(TEST_PATH);
+  list_p list = list_create_mapped(TEST_PATH, sizeof(long));
+  assert(list != NULL && "Error: Cannot create mapped list");
+  assert(list_size(list) == 0 && "Error: New mapped list not empty");
+
+  // Enough items for several resizes of the file
+  int n = 100000;
+  for (long i = 0; i < n; i++)
+    list_append(list, &i);
+  assert(list_size(list) == n && "Error: Incorrect size");
+  assert(list_sync(list) == 0 && "Error: Cannot sync mapped list");
+
+  long value = -1;
+  list_set(list, &value, 0);
+  list_delete(list);
+
+  list = list_create_mapped(TEST_PATH, sizeof(long));
+  assert(list != NULL && "Error: Cannot reopen mapped list");
+  assert(list_size(list) == n && "Error: Incorrect size after reopen");
+  assert(*(const long *)list_at(list, 0) == -1 && "Error: Write after sync not saved");
+  for (long i = 1; i < n; i++)
+  {
+    assert(*(const long *)list_at(list, i) == i && "Error: Incorrect value after reopen");
+  }
+  printf("Create, append and reopen - OK\n");
+
+  printf("Shrink\n");
+  for (int i = 0; i < n - 10; i++)
+    list_remove(list, list_size(list) - 1);
+  assert(list_size(list) == 10 && "Error: Incorrect size");
+  list_delete(list);
+
+  list = list_create_mapped(TEST_PATH, sizeof(long));
+  assert(list != NULL && "Error: Cannot reopen mapped list");
+  assert(list_size(list) == 10 && "Error: Incorrect size after reopen");
+  for (long i = 1; i < 10; i++)
+  {
+    assert(*(const long *)list_at(list, i) == i && "Error: Incorrect value after reopen");
+  }
+  list_delete(list);
+  printf("Shrink - OK\n");
+
+  printf("Invalid files\n");
+  assert(list_create_mapped(TEST_PATH, sizeof(int)) == NULL && "Error: Wrong element size accepted");
+
+  // A (sparse) list file of 4GB of chars has more items than fit in an int
+  unlink(TEST_PATH);
+  list = list_create_mapped(TEST_PATH, sizeof(char));
+  assert(list != NULL && "Error: Cannot create mapped list");
+  list_delete(list);
+  int extended = truncate(TEST_PATH, (off_t)1 << 32);
+  assert(extended == 0 && "Error: Cannot extend test file");
+  assert(list_create_mapped(TEST_PATH, sizeof(char)) == NULL && "Error: Oversized file accepted");
+
+  FILE *file = fopen(TEST_PATH, "w");
+  assert(file != NULL && "Error: Cannot write test file");
+  fputs("this is not a list file", file);
+  fclose(file);
+  assert(list_create_mapped(TEST_PATH, sizeof(long)) == NULL && "Error: Invalid file accepted");
+  assert(list_create_mapped("/tmp", sizeof(long)) == NULL && "Error: Directory accepted");
+
+  // list_sync has no effect on a heap list
+  list = list_create(sizeof(long));
+  assert(list_sync(list) == 0 && "Error: Sync of heap list failed");
+  list_delete(list);
+  unlink(TEST_PATH);
+  printf("Invalid files - OK\n");
+}
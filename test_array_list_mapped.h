@@ -0,0 +1,6 @@
+#ifndef TEST_ARRAY_LIST_MAPPED
+#define TEST_ARRAY_LIST_MAPPED
+
+void test_array_list_mapped(void);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * Tests for the array_list binary search functions.
+ * Every variant is checked against a linear scan.
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include "array_list.h"
+
+static int compare_int(const void *a, const void *b)
+{
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+/*
+Check the searches on a sorted list of n items (with duplicates)
+for every value from below the smallest to above the largest item
+*/
+static void check_searches(int n)
+{
+  list_p list = list_create(sizeof(int));
+  for (int i = 0; i < n; i++)
+  {
+    int value = 2 * (i / 3); // each even value three times
+    list_append(list, &value);
+  }
+  list_eytzinger_p index = list_eytzinger_create(list, compare_int);
+
+  for (int value = -2; value <= 2 * (n / 3) + 2; value++)
+  {
+    int lower = 0;
+    while (lower < n && *(const int *)list_at(list, lower) < value)
+      lower++;
+    int upper = lower;
+    while (upper < n && *(const int *)list_at(list, upper) == value)
+      upper++;
+
+    assert(list_lower_bound(list, &value, compare_int) == lower && "Error: Incorrect lower bound");
+    assert(list_upper_bound(list, &value, compare_int) == upper && "Error: Incorrect upper bound");
+    assert(list_lower_bound_branchless(list, &value, compare_int) == lower && "Error: Incorrect branchless lower bound");
+    assert(list_eytzinger_lower_bound(index, &value) == lower && "Error: Incorrect Eytzinger lower bound");
+    assert(list_binary_search(list, &value, compare_int) == (upper > lower ? lower : -1) && "Error: Incorrect binary search");
+  }
+
+  list_eytzinger_delete(index);
+  list_delete(list);
+}
+
+void test_array_list_search(void)
+{
+  printf("\n========================================");
+  printf("\n======== Array List Search Test ========");
+  printf("\n========================================\n\n");
+
+  for (int n = 0; n <= 70; n++)
+    check_searches(n);
+  check_searches(1000);
+  check_searches(4099);
+  printf("Lower/upper bound, binary search, branchless and Eytzinger - OK\n");
+
+  printf("Sorted insert\n");
+  list_p list = list_create(sizeof(int));
+  for (int i = 0; i < 500; i++)
+  {
+    int value = (i * 7919) % 101;
+    int index = list_insert_sorted(list, &value, compare_int);
+    assert(*(const int *)list_at(list, index) == value && "Error: Value not at the returned index");
+    assert((index + 1 == list_size(list) || *(const int *)list_at(list, index + 1) > value) &&
+           "Error: Value not inserted after equal items");
+  }
+  for (int i = 1; i < 500; i++)
+  {
+    assert(*(const int *)list_at(list, i - 1) <= *(const int *)list_at(list, i) && "Error: List not sorted");
+  }
+  list_delete(list);
+  printf("Sorted insert - OK\n");
+}
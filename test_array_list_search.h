@@ -0,0 +1,6 @@
+#ifndef TEST_ARRAY_LIST_SEARCH
+#define TEST_ARRAY_LIST_SEARCH
+
+void test_array_list_search(void);
+
+#endif
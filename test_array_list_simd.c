@@ -0,0 +1,141 @@
+/**
+ * Tests for the array_list search, fill and reduction functions.
+ * The vector kernels at every level supported by the CPU are
+ * checked against the scalar kernels.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "array_list_simd_p.h"
+
+// Largest list length used in the kernel tests.
+// Lengths 0..40 cover every vector tail; the larger lengths cover the main loops
+#define MAX_TEST_LENGTH 1027
+
+static const char *level_names[] = {"scalar", "SSE2", "AVX2"};
+
+/*
+Check every public function against the scalar kernels for lists of n items
+*/
+static void check_kernels(int n)
+{
+  list_p list32 = list_create(sizeof(int32_t));
+  list_p list64 = list_create(sizeof(int64_t));
+  list_p listf = list_create(sizeof(float));
+  list_p listd = list_create(sizeof(double));
+
+  for (int i = 0; i < n; i++)
+  {
+    // Small integer values, so float/double sums are exact in any order
+    int32_t v32 = rand() % 2001 - 1000;
+    int64_t v64 = (int64_t)v32 * 3000000000LL;
+    float vf = (float)v32;
+    double vd = (double)v32;
+    list_append(list32, &v32);
+    list_append(list64, &v64);
+    list_append(listf, &vf);
+    list_append(listd, &vd);
+  }
+
+  const void *data32, *data64, *dataf, *datad;
+  int length;
+  list_data_span(list32, &data32, &length);
+  list_data_span(list64, &data64, &length);
+  list_data_span(listf, &dataf, &length);
+  list_data_span(listd, &datad, &length);
+
+  assert(list_sum_i32(list32) == _sum_i32_scalar(data32, n) && "Error: list_sum_i32 mismatch");
+  assert(list_sum_i64(list64) == _sum_i64_scalar(data64, n) && "Error: list_sum_i64 mismatch");
+  assert(list_sum_f32(listf) == _sum_f32_scalar(dataf, n) && "Error: list_sum_f32 mismatch");
+  assert(list_sum_f64(listd) == _sum_f64_scalar(datad, n) && "Error: list_sum_f64 mismatch");
+
+  if (n > 0)
+  {
+    assert(list_min_i32(list32) == _extreme_i32_scalar(data32, n, false) && "Error: list_min_i32 mismatch");
+    assert(list_max_i32(list32) == _extreme_i32_scalar(data32, n, true) && "Error: list_max_i32 mismatch");
+    assert(list_min_i64(list64) == _extreme_i64_scalar(data64, n, false) && "Error: list_min_i64 mismatch");
+    assert(list_max_i64(list64) == _extreme_i64_scalar(data64, n, true) && "Error: list_max_i64 mismatch");
+    assert(list_min_f32(listf) == _extreme_f32_scalar(dataf, n, false) && "Error: list_min_f32 mismatch");
+    assert(list_max_f32(listf) == _extreme_f32_scalar(dataf, n, true) && "Error: list_max_f32 mismatch");
+    assert(list_min_f64(listd) == _extreme_f64_scalar(datad, n, false) && "Error: list_min_f64 mismatch");
+    assert(list_max_f64(listd) == _extreme_f64_scalar(datad, n, true) && "Error: list_max_f64 mismatch");
+  }
+
+  // Search for values present (including the last item) and absent
+  int32_t keys32[] = {0, 1000, -1000, 5000};
+  for (int k = 0; k < 4; k++)
+  {
+    int64_t key64 = (int64_t)keys32[k] * 3000000000LL;
+    assert(list_find(list32, &keys32[k]) == _find_32_scalar(data32, n, (uint32_t)keys32[k]) && "Error: list_find (32 bit) mismatch");
+    assert(list_count(list32, &keys32[k]) == _count_32_scalar(data32, n, (uint32_t)keys32[k]) && "Error: list_count (32 bit) mismatch");
+    assert(list_find(list64, &key64) == _find_64_scalar(data64, n, (uint64_t)key64) && "Error: list_find (64 bit) mismatch");
+    assert(list_count(list64, &key64) == _count_64_scalar(data64, n, (uint64_t)key64) && "Error: list_count (64 bit) mismatch");
+  }
+  if (n > 0)
+  {
+    int32_t last32;
+    int64_t last64;
+    list_get(list32, n - 1, &last32);
+    list_get(list64, n - 1, &last64);
+    assert(list_find(list32, &last32) == _find_32_scalar(data32, n, (uint32_t)last32) && "Error: list_find (32 bit) mismatch");
+    assert(list_find(list64, &last64) == _find_64_scalar(data64, n, (uint64_t)last64) && "Error: list_find (64 bit) mismatch");
+  }
+
+  list_delete(list32);
+  list_delete(list64);
+  list_delete(listf);
+  list_delete(listd);
+}
+
+void test_array_list_simd(void)
+{
+  printf("\n===================================");
+  printf("\n======== List Search Test =========");
+  printf("\n===================================\n\n");
+
+  srand(12345);
+
+  printf("--- Find/Count/Fill (12 byte items) ---\n");
+  list_p list = list_create(3 * sizeof(int));
+  int item[3] = {1, 2, 3};
+  for (int i = 0; i < 10; i++)
+  {
+    item[0] = i;
+    list_append(list, item);
+  }
+  item[0] = 7;
+  assert(list_find(list, item) == 7 && "Error: expected item at index 7");
+  assert(list_count(list, item) == 1 && "Error: expected 1 matching item");
+  item[0] = 70;
+  assert(list_find(list, item) == -1 && "Error: expected no matching item");
+  list_fill(list, item);
+  assert(list_count(list, item) == 10 && "Error: expected 10 matching items after fill");
+  printf("Find/Count/Fill test - OK\n");
+  list_delete(list);
+
+  printf("\n--- Fill (4 byte items) ---\n");
+  list = list_create(sizeof(int32_t));
+  for (int32_t i = 0; i < 1000; i++)
+    list_append(list, &i);
+  int32_t seven = 7;
+  list_fill(list, &seven);
+  assert(list_count(list, &seven) == 1000 && "Error: expected 1000 matching items after fill");
+  assert(list_sum_i32(list) == 7000 && "Error: expected sum of 7000 after fill");
+  printf("Fill test - OK\n");
+  list_delete(list);
+
+  _simd_level_t max_level = _simd_max_level();
+  for (int level = SIMD_SCALAR; level <= (int)max_level; level++)
+  {
+    printf("\n--- Kernels (%s) ---\n", level_names[level]);
+    _simd_set_level((_simd_level_t)level);
+    for (int n = 0; n <= 40; n++)
+      check_kernels(n);
+    check_kernels(1000);
+    check_kernels(MAX_TEST_LENGTH);
+    printf("%s kernels match scalar - OK\n", level_names[level]);
+  }
+  _simd_set_level(max_level);
+}
@@ -0,0 +1,7 @@
+
+#ifndef TEST_ARRAY_LIST_SIMD
+#define TEST_ARRAY_LIST_SIMD
+
+void test_array_list_simd(void);
+
+#endif
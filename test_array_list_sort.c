@@ -0,0 +1,160 @@
+/**
+ * Tests for the array_list sort functions.
+ * Results are checked against qsort, and the parallel sort is run
+ * with several threads whatever the number of CPUs.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "array_list_sort_p.h"
+
+// An item with a key to sort by and its original position
+struct keyed
+{
+  int key;
+  int position;
+};
+
+static int compare_int(const void *a, const void *b)
+{
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int compare_keyed(const void *a, const void *b)
+{
+  return compare_int(&((const struct keyed *)a)->key, &((const struct keyed *)b)->key);
+}
+
+/*
+Check list_sort and list_stable_sort against qsort for n ints
+(threads > 1 runs the parallel sort with that many threads)
+*/
+static void check_int_sort(int n, int threads)
+{
+  list_p list = list_create(sizeof(int));
+  int *expected = malloc((n + 1) * sizeof(int));
+  for (int i = 0; i < n; i++)
+  {
+    expected[i] = rand() % 1000 - 500;
+    list_append(list, &expected[i]);
+  }
+  qsort(expected, n, sizeof(int), compare_int);
+
+  if (threads > 1)
+    _parallel_sort(list, compare_int, false, threads);
+  else
+    list_sort(list, compare_int);
+  assert((n == 0 || memcmp(list_at(list, 0), expected, n * sizeof(int)) == 0) && "Error: list_sort result differs from qsort");
+
+  list_delete(list);
+  free(expected);
+}
+
+/*
+Check that list_stable_sort keeps equal keys in their original order
+*/
+static void check_stable_sort(int n, int threads)
+{
+  list_p list = list_create(sizeof(struct keyed));
+  for (int i = 0; i < n; i++)
+  {
+    struct keyed item = {rand() % 16, i};
+    list_append(list, &item);
+  }
+
+  if (threads > 1)
+    _parallel_sort(list, compare_keyed, true, threads);
+  else
+    list_stable_sort(list, compare_keyed);
+
+  for (int i = 1; i < n; i++)
+  {
+    const struct keyed *prev = list_at(list, i - 1);
+    const struct keyed *item = list_at(list, i);
+    assert((prev->key < item->key || (prev->key == item->key && prev->position < item->position)) &&
+           "Error: list_stable_sort is not sorted or not stable");
+  }
+  list_delete(list);
+}
+
+static void check_radix_sort(int n)
+{
+  list_p li32 = list_create(sizeof(int32_t));
+  list_p lu64 = list_create(sizeof(uint64_t));
+  list_p lf32 = list_create(sizeof(float));
+  list_p lf64 = list_create(sizeof(double));
+  for (int i = 0; i < n; i++)
+  {
+    int32_t v = rand() - RAND_MAX / 2;
+    uint64_t u = ((uint64_t)rand() << 33) ^ (uint64_t)rand();
+    float f = (float)v / 1000.0f;
+    double d = (double)v * 1e10;
+    list_append(li32, &v);
+    list_append(lu64, &u);
+    list_append(lf32, &f);
+    list_append(lf64, &d);
+  }
+  list_radix_sort(li32, LIST_KEY_I32);
+  list_radix_sort(lu64, LIST_KEY_U64);
+  list_radix_sort(lf32, LIST_KEY_F32);
+  list_radix_sort(lf64, LIST_KEY_F64);
+
+  for (int i = 1; i < n; i++)
+  {
+    assert(*(const int32_t *)list_at(li32, i - 1) <= *(const int32_t *)list_at(li32, i) && "Error: int32 radix sort");
+    assert(*(const uint64_t *)list_at(lu64, i - 1) <= *(const uint64_t *)list_at(lu64, i) && "Error: uint64 radix sort");
+    assert(*(const float *)list_at(lf32, i - 1) <= *(const float *)list_at(lf32, i) && "Error: float radix sort");
+    assert(*(const double *)list_at(lf64, i - 1) <= *(const double *)list_at(lf64, i) && "Error: double radix sort");
+  }
+  list_delete(li32);
+  list_delete(lu64);
+  list_delete(lf32);
+  list_delete(lf64);
+}
+
+void test_array_list_sort(void)
+{
+  printf("\n======================================");
+  printf("\n======== Array List Sort Test ========");
+  printf("\n======================================\n\n");
+
+  int lengths[] = {0, 1, 2, 15, 16, 17, 100, 1000, 10007};
+  for (int i = 0; i < 9; i++)
+  {
+    check_int_sort(lengths[i], 1);
+    check_stable_sort(lengths[i], 1);
+    check_radix_sort(lengths[i]);
+  }
+  printf("Sequential sorts - OK\n");
+
+  // Odd thread counts leave a run to be carried to the next merge round
+  int threads[] = {2, 3, 4, 7};
+  for (int i = 0; i < 4; i++)
+  {
+    check_int_sort(50000, threads[i]);
+    check_stable_sort(50000, threads[i]);
+  }
+  printf("Parallel sorts - OK\n");
+
+  // Already sorted and reversed input
+  list_p list = list_create(sizeof(int));
+  for (int i = 0; i < 1000; i++)
+    list_append(list, &i);
+  list_stable_sort(list, compare_int);
+  for (int i = 0; i < 1000; i++)
+  {
+    int value = 999 - i;
+    list_set(list, &value, i);
+  }
+  list_stable_sort(list, compare_int);
+  for (int i = 0; i < 1000; i++)
+  {
+    assert(*(const int *)list_at(list, i) == i && "Error: Reversed input not sorted");
+  }
+  list_delete(list);
+  printf("Sorted and reversed input - OK\n");
+}
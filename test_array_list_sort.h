@@ -0,0 +1,6 @@
+#ifndef TEST_ARRAY_LIST_SORT
+#define TEST_ARRAY_LIST_SORT
+
+void test_array_list_sort(void);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * Basic tests for the typed array lists
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "array_list_typed.h"
+
+DEFINE_ARRAY_LIST(int)
+DEFINE_ARRAY_LIST(double)
+
+void test_array_list_typed(void)
+{
+  printf("\n=================================");
+  printf("\n======== Typed List Test ========");
+  printf("\n=================================\n\n");
+
+  list_int_p int_list = list_int_create();
+  printf("int list created\n\n");
+
+  printf("--- Append/Insert ---\n");
+  list_int_append(int_list, 10);
+  list_int_append(int_list, 30);
+  list_int_insert(int_list, 20, 1);
+  list_int_insert(int_list, 0, 0);
+  assert(list_int_size(int_list) == 4 && "Error: Incorrect list size after insert");
+  for (int i = 0; i < 4; i++)
+    assert(list_int_get(int_list, i) == i * 10 && "Error: Incorrect value after insert");
+  printf("Append/Insert test - OK\n");
+
+  printf("\n--- Set/Remove ---\n");
+  list_int_set(int_list, -1, 3);
+  assert(list_int_get(int_list, 3) == -1 && "Error: expected -1 at index 3");
+  list_int_remove(int_list, 0);
+  assert(list_int_size(int_list) == 3 && "Error: Incorrect list size after remove");
+  assert(list_int_get(int_list, 0) == 10 && "Error: expected 10 at index 0");
+  assert(list_int_data(int_list)[2] == -1 && "Error: expected -1 at index 2 of data");
+  printf("Set/Remove test - OK\n");
+
+  printf("\n--- Append/Remove ~1000 items ---\n");
+  for (int i = 0; i < 1000; i++)
+    list_int_append(int_list, i);
+  assert(list_int_size(int_list) == 1003 && "Error: Incorrect list size after appending 1000 items");
+  while (list_int_size(int_list) > 10)
+    list_int_remove(int_list, list_int_size(int_list) - 1);
+  assert(list_int_get(int_list, 9) == 6 && "Error: expected 6 at index 9");
+  printf("Append/Remove test - OK\n");
+  list_int_delete(int_list);
+
+  printf("\n--- double list ---\n");
+  list_double_p double_list = list_double_create();
+  for (int i = 0; i < 100; i++)
+    list_double_append(double_list, i * 0.5);
+  assert(list_double_get(double_list, 99) == 49.5 && "Error: expected 49.5 at index 99");
+  list_double_insert(double_list, -0.25, 0);
+  assert(list_double_get(double_list, 0) == -0.25 && "Error: expected -0.25 at index 0");
+  assert(list_double_get(double_list, 1) == 0.0 && "Error: expected 0.0 at index 1");
+  printf("double list test - OK\n");
+  list_double_delete(double_list);
+}
@@ -0,0 +1,7 @@
+
+#ifndef TEST_ARRAY_LIST_TYPED
+#define TEST_ARRAY_LIST_TYPED
+
+void test_array_list_typed(void);
+
+#endif
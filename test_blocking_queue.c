@@ -0,0 +1,148 @@
+/**
+ * Basic tests for blocking queue data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "blocking_queue.h"
+
+// Number of threads on each side and items per producer in the threaded test
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+#define ITEMS_PER_PRODUCER 10000
+
+static blocking_queue_p shared_queue;
+
+static void *producer(void *arg)
+{
+  int id = *(int *)arg;
+  for (int i = 0; i < ITEMS_PER_PRODUCER; i++)
+  {
+    int value = id * ITEMS_PER_PRODUCER + i;
+    blocking_queue_status status = blocking_queue_push(shared_queue, &value);
+    assert(status == BLOCKING_QUEUE_OK && "Error: Push to open queue failed");
+  }
+  return NULL;
+}
+
+// Pops until the queue is closed and empty, returning the sum of the values
+static void *consumer(void *arg)
+{
+  long *sum = arg;
+  int value;
+  while (blocking_queue_pop(shared_queue, &value) == BLOCKING_QUEUE_OK)
+    *sum += value;
+  return NULL;
+}
+
+// Waits on an empty queue, returning the status it was woken with
+static void *waiter(void *arg)
+{
+  blocking_queue_status *status = arg;
+  int value;
+  *status = blocking_queue_pop(shared_queue, &value);
+  return NULL;
+}
+
+// Pushes one more item than fits in the queue
+static void *pusher(void *arg)
+{
+  int *pushed = arg;
+  for (int i = 0; i < 3; i++)
+  {
+    blocking_queue_push(shared_queue, &i);
+    (*pushed)++;
+  }
+  return NULL;
+}
+
+void test_blocking_queue(void)
+{
+  printf("\n=====================================");
+  printf("\n======== Blocking Queue Test ========");
+  printf("\n=====================================\n\n");
+
+  blocking_queue_p queue = blocking_queue_create(sizeof(int), 0);
+  int value = 101;
+
+  printf("Push and pop\n");
+  assert(blocking_queue_push(queue, &value) == BLOCKING_QUEUE_OK && "Error: Push failed");
+  value = 201;
+  blocking_queue_push(queue, &value);
+  assert(blocking_queue_size(queue) == 2 && "Error: Incorrect queue size after push");
+  assert(blocking_queue_pop(queue, &value) == BLOCKING_QUEUE_OK && value == 101 && "Error: Incorrect popped value");
+  assert(blocking_queue_pop_timed(queue, &value, 0) == BLOCKING_QUEUE_OK && value == 201 && "Error: Incorrect popped value");
+
+  printf("Timed pop from empty queue\n");
+  value = -1;
+  assert(blocking_queue_pop_timed(queue, &value, 0) == BLOCKING_QUEUE_TIMEOUT && "Error: Expected timeout");
+  assert(blocking_queue_pop_timed(queue, &value, 20) == BLOCKING_QUEUE_TIMEOUT && "Error: Expected timeout");
+  assert(value == -1 && "Error: Timed out pop changed out");
+
+  printf("Close wakes a waiting consumer\n");
+  shared_queue = queue;
+  blocking_queue_status status = BLOCKING_QUEUE_OK;
+  pthread_t thread;
+  pthread_create(&thread, NULL, waiter, &status);
+  usleep(10000);
+  blocking_queue_close(queue);
+  pthread_join(thread, NULL);
+  assert(status == BLOCKING_QUEUE_CLOSED && "Error: Waiter not woken by close");
+  assert(blocking_queue_push(queue, &value) == BLOCKING_QUEUE_CLOSED && "Error: Push to closed queue succeeded");
+  blocking_queue_delete(queue);
+
+  printf("Items left in a closed queue are still popped\n");
+  queue = blocking_queue_create(sizeof(int), 0);
+  value = 7;
+  blocking_queue_push(queue, &value);
+  blocking_queue_close(queue);
+  assert(blocking_queue_pop(queue, &value) == BLOCKING_QUEUE_OK && value == 7 && "Error: Remaining item not popped");
+  assert(blocking_queue_pop(queue, &value) == BLOCKING_QUEUE_CLOSED && "Error: Expected closed queue");
+  blocking_queue_delete(queue);
+
+  printf("Producer waits while the queue is full\n");
+  queue = blocking_queue_create(sizeof(int), 2);
+  shared_queue = queue;
+  int pushed = 0;
+  pthread_create(&thread, NULL, pusher, &pushed);
+  usleep(10000);
+  assert(blocking_queue_size(queue) == 2 && "Error: Capacity exceeded");
+  assert(blocking_queue_pop(queue, &value) == BLOCKING_QUEUE_OK && value == 0 && "Error: Incorrect popped value");
+  pthread_join(thread, NULL);
+  assert(pushed == 3 && blocking_queue_size(queue) == 2 && "Error: Producer not woken by pop");
+  blocking_queue_delete(queue);
+
+  printf("Multi-thread test\n");
+  queue = blocking_queue_create(sizeof(int), 64);
+  shared_queue = queue;
+  pthread_t producers[NUM_PRODUCERS];
+  pthread_t consumers[NUM_CONSUMERS];
+  int ids[NUM_PRODUCERS];
+  long sums[NUM_CONSUMERS] = {0};
+  for (int i = 0; i < NUM_CONSUMERS; i++)
+    pthread_create(&consumers[i], NULL, consumer, &sums[i]);
+  for (int i = 0; i < NUM_PRODUCERS; i++)
+  {
+    ids[i] = i;
+    pthread_create(&producers[i], NULL, producer, &ids[i]);
+  }
+  for (int i = 0; i < NUM_PRODUCERS; i++)
+    pthread_join(producers[i], NULL);
+  blocking_queue_close(queue);
+
+  long total = 0;
+  for (int i = 0; i < NUM_CONSUMERS; i++)
+  {
+    pthread_join(consumers[i], NULL);
+    total += sums[i];
+  }
+  long n = (long)NUM_PRODUCERS * ITEMS_PER_PRODUCER;
+  assert(total == n * (n - 1) / 2 && "Error: Items lost or duplicated");
+  printf("Multi-thread test - OK\n");
+
+  blocking_queue_delete(queue);
+  printf("Queue Deleted\n");
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_BLOCKING_QUEUE
+#define TEST_BLOCKING_QUEUE
+
+void test_blocking_queue(void);
+
+#endif
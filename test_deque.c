@@ -0,0 +1,65 @@
+/**
+ * Basic tests for deque data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include "deque.h"
+
+void test_deque(void)
+{
+  printf("\n============================");
+  printf("\n======== Deque Test ========");
+  printf("\n============================\n\n");
+
+  deque_p deque = deque_create(sizeof(int));
+  int value = -1;
+
+  printf("Pop from empty deque\n");
+  assert(!deque_pop_front(deque, &value) && !deque_pop_back(deque, &value) && "Error: Popped from empty deque");
+  assert(value == -1 && "Error: Pop from empty deque changed out");
+
+  printf("Push 1000 items at the front and 1000 at the back\n");
+  for (int i = 0; i < 1000; i++)
+  {
+    deque_push_back(deque, &i);
+    int front = -1 - i;
+    deque_push_front(deque, &front);
+  }
+  assert(deque_size(deque) == 2000 && "Error: Incorrect deque size after push");
+
+  // The deque now holds -1000 .. 999 in order
+  for (int i = 0; i < 2000; i++)
+  {
+    deque_get(deque, i, &value);
+    assert(value == i - 1000 && "Error: Incorrect value at index");
+  }
+  value = 12345;
+  deque_set(deque, &value, 1000);
+  deque_get(deque, 1000, &value);
+  assert(value == 12345 && "Error: Incorrect value after set");
+  printf("Indexing - OK\n");
+
+  printf("Pop everything from alternate ends (shrinks the buffer)\n");
+  for (int i = 0; i < 1000; i++)
+  {
+    assert(deque_pop_front(deque, &value) && value == i - 1000 && "Error: Incorrect value from front");
+    assert(deque_pop_back(deque, &value) && value == (i == 999 ? 12345 : 999 - i) && "Error: Incorrect value from back");
+  }
+  assert(deque_size(deque) == 0 && "Error: Deque not empty");
+
+  printf("Use as a queue with the data wrapping around the buffer\n");
+  for (int i = 0; i < 10; i++)
+    deque_push_back(deque, &i);
+  for (int i = 10; i < 5000; i++)
+  {
+    deque_push_back(deque, &i);
+    deque_pop_front(deque, &value);
+    assert(value == i - 10 && "Error: Incorrect value from front");
+  }
+  printf("Wrap-around - OK\n");
+
+  deque_delete(deque);
+  printf("Deque Deleted\n");
+}
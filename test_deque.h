@@ -0,0 +1,6 @@
+#ifndef TEST_DEQUE
+#define TEST_DEQUE
+
+void test_deque(void);
+
+#endif
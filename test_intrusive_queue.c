@@ -0,0 +1,70 @@
+/**
+ * Basic tests for intrusive queue data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include "intrusive_queue.h"
+
+// An item which can be in two queues at once
+struct job
+{
+  int id;
+  queue_link link;
+  queue_link priority_link;
+};
+
+void test_intrusive_queue(void)
+{
+  printf("\n======================================");
+  printf("\n======== Intrusive Queue Test ========");
+  printf("\n======================================\n\n");
+
+  struct job jobs[8];
+  intrusive_queue queue;
+  intrusive_queue priority;
+  intrusive_queue_init(&queue);
+  intrusive_queue_init(&priority);
+
+  printf("Dequeue from empty queue\n");
+  assert(intrusive_queue_dequeue(&queue) == NULL && "Error: Dequeue from empty queue returned an item");
+  assert(intrusive_queue_peek(&queue) == NULL && "Error: Peek at empty queue returned an item");
+
+  printf("Enqueue 8 items, odd items also in a second queue\n");
+  for (int i = 0; i < 8; i++)
+  {
+    jobs[i].id = i;
+    intrusive_queue_enqueue(&queue, &jobs[i].link);
+    if (i % 2)
+      intrusive_queue_enqueue(&priority, &jobs[i].priority_link);
+  }
+  assert(intrusive_queue_size(&queue) == 8 && "Error: Incorrect queue size after enqueue");
+  assert(intrusive_queue_size(&priority) == 4 && "Error: Incorrect queue size after enqueue");
+
+  struct job *head = queue_entry(intrusive_queue_peek(&queue), struct job, link);
+  assert(head == &jobs[0] && "Error: Incorrect item at head of queue");
+
+  for (int i = 1; i < 8; i += 2)
+  {
+    struct job *job = queue_entry(intrusive_queue_dequeue(&priority), struct job, priority_link);
+    assert(job->id == i && "Error: Incorrect dequeued item");
+  }
+  assert(intrusive_queue_dequeue(&priority) == NULL && "Error: Expected empty queue");
+
+  for (int i = 0; i < 8; i++)
+  {
+    struct job *job = queue_entry(intrusive_queue_dequeue(&queue), struct job, link);
+    assert(job == &jobs[i] && "Error: Incorrect dequeued item");
+  }
+  assert(intrusive_queue_size(&queue) == 0 && "Error: Incorrect queue size after dequeue");
+  printf("FIFO order in both queues - OK\n");
+
+  printf("Reuse the queue after it is emptied\n");
+  intrusive_queue_enqueue(&queue, &jobs[3].link);
+  intrusive_queue_enqueue(&queue, &jobs[5].link);
+  assert(queue_entry(intrusive_queue_dequeue(&queue), struct job, link)->id == 3 && "Error: Incorrect dequeued item");
+  assert(queue_entry(intrusive_queue_dequeue(&queue), struct job, link)->id == 5 && "Error: Incorrect dequeued item");
+  assert(intrusive_queue_peek(&queue) == NULL && "Error: Expected empty queue");
+  printf("Reuse - OK\n");
+}
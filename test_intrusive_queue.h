@@ -0,0 +1,6 @@
+#ifndef TEST_INTRUSIVE_QUEUE
+#define TEST_INTRUSIVE_QUEUE
+
+void test_intrusive_queue(void);
+
+#endif
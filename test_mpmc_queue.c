@@ -0,0 +1,110 @@
+/**
+ * Basic tests for mpmc queue data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "mpmc_queue.h"
+
+// Number of threads on each side and items per producer in the threaded test
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+#define ITEMS_PER_PRODUCER 20000
+
+static mpmc_queue_p shared_queue;
+static atomic_int seen[NUM_PRODUCERS * ITEMS_PER_PRODUCER];
+
+static void *producer(void *arg)
+{
+  int id = *(int *)arg;
+  for (int i = 0; i < ITEMS_PER_PRODUCER; i++)
+  {
+    int value = id * ITEMS_PER_PRODUCER + i;
+    mpmc_queue_enqueue(shared_queue, &value);
+  }
+  return NULL;
+}
+
+static void *consumer(void *arg)
+{
+  (void)arg;
+  // Items from one producer must be seen in the order they were enqueued
+  int last[NUM_PRODUCERS];
+  for (int p = 0; p < NUM_PRODUCERS; p++)
+    last[p] = -1;
+
+  for (int i = 0; i < NUM_PRODUCERS * ITEMS_PER_PRODUCER / NUM_CONSUMERS; i++)
+  {
+    int value;
+    mpmc_queue_dequeue(shared_queue, &value);
+    int id = value / ITEMS_PER_PRODUCER;
+    assert(value % ITEMS_PER_PRODUCER > last[id] && "Error: Items from one producer out of order");
+    last[id] = value % ITEMS_PER_PRODUCER;
+    atomic_fetch_add(&seen[value], 1);
+  }
+  return NULL;
+}
+
+void test_mpmc_queue(void)
+{
+  printf("\n=================================");
+  printf("\n======== MPMC Queue Test ========");
+  printf("\n=================================\n\n");
+
+  mpmc_queue_p queue = mpmc_queue_create(sizeof(int), 4);
+
+  int value;
+  printf("Enqueue 4 items\n");
+  for (int i = 1; i <= 4; i++)
+  {
+    value = i * 100 + 1;
+    assert(mpmc_queue_try_enqueue(queue, &value) == MPMC_QUEUE_OK && "Error: Enqueue failed on non-full queue");
+  }
+  assert(mpmc_queue_size(queue) == 4 && "Error: Incorrect queue size after enqueue");
+  value = 501;
+  assert(mpmc_queue_try_enqueue(queue, &value) == MPMC_QUEUE_FULL && "Error: Expected MPMC_QUEUE_FULL");
+  printf("Full queue returns MPMC_QUEUE_FULL - OK\n\n");
+
+  for (int i = 0; i < 4; i++)
+  {
+    assert(mpmc_queue_try_dequeue(queue, &value) == MPMC_QUEUE_OK && "Error: Dequeue failed on non-empty queue");
+    printf("Dequeue item %d: %d\n", i + 1, value);
+    assert(value == (i + 1) * 100 + 1 && "Error: Incorrect dequeued value");
+  }
+
+  value = -1;
+  assert(mpmc_queue_try_dequeue(queue, &value) == MPMC_QUEUE_EMPTY && "Error: Expected MPMC_QUEUE_EMPTY");
+  assert(value == -1 && "Error: Dequeue from empty queue changed out");
+  printf("\nEmpty queue returns MPMC_QUEUE_EMPTY - OK\n");
+  mpmc_queue_delete(queue);
+
+  printf("Transfer %d items from %d producers to %d consumers\n",
+         NUM_PRODUCERS * ITEMS_PER_PRODUCER, NUM_PRODUCERS, NUM_CONSUMERS);
+  shared_queue = mpmc_queue_create(sizeof(int), 64);
+  pthread_t producers[NUM_PRODUCERS];
+  pthread_t consumers[NUM_CONSUMERS];
+  int ids[NUM_PRODUCERS];
+  for (int i = 0; i < NUM_CONSUMERS; i++)
+    pthread_create(&consumers[i], NULL, consumer, NULL);
+  for (int i = 0; i < NUM_PRODUCERS; i++)
+  {
+    ids[i] = i;
+    pthread_create(&producers[i], NULL, producer, &ids[i]);
+  }
+  for (int i = 0; i < NUM_PRODUCERS; i++)
+    pthread_join(producers[i], NULL);
+  for (int i = 0; i < NUM_CONSUMERS; i++)
+    pthread_join(consumers[i], NULL);
+
+  for (int i = 0; i < NUM_PRODUCERS * ITEMS_PER_PRODUCER; i++)
+    assert(atomic_load(&seen[i]) == 1 && "Error: Item lost or duplicated");
+  assert(mpmc_queue_size(shared_queue) == 0 && "Error: Queue not empty after transfer");
+  printf("Multi-thread test - OK\n");
+
+  mpmc_queue_delete(shared_queue);
+  printf("Queue Deleted\n\n");
+}
@@ -0,0 +1,7 @@
+
+#ifndef TEST_MPMC_QUEUE
+#define TEST_MPMC_QUEUE
+
+void test_mpmc_queue(void);
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * Tests for the perf_counters module. The calls are only recorded when
+ * built with INSTRUMENT=1, and the hardware counters only where the
+ * system provides them, so the tests accept either.
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include "perf_counters.h"
+#include "array_list.h"
+#include "queue.h"
+
+void test_perf_counters(void)
+{
+  printf("\n====================================");
+  printf("\n======== Perf Counters Test ========");
+  printf("\n====================================\n\n");
+
+  perf_counters_reset();
+  list_p list = list_create(sizeof(int));
+  queue_p queue = queue_create(sizeof(int));
+  for (int i = 0; i < 100; i++)
+  {
+    list_insert(list, &i, 0);
+    queue_enqueue(queue, &i);
+  }
+  int value;
+  for (int i = 0; i < 60; i++)
+  {
+    list_remove(list, 0);
+    queue_dequeue(queue, &value);
+  }
+  list_delete(list);
+  queue_delete(queue);
+
+  perf_stats stats;
+  long long expected[PERF_NUM_OPS] = {100, 60, -1, 100, 60};
+  for (int op = 0; op < PERF_NUM_OPS; op++)
+  {
+    perf_counters_get(op, &stats);
+    if (!perf_counters_enabled())
+    {
+      assert(stats.calls == 0 && "Error: Calls recorded without instrumentation");
+      continue;
+    }
+
+    if (expected[op] >= 0)
+    {
+      assert(stats.calls == expected[op] && "Error: Incorrect number of calls");
+    }
+    else
+    {
+      assert(stats.calls > 0 && "Error: Resizes not recorded");
+    }
+    assert(stats.nanoseconds >= 0 && stats.cycles >= -1 && stats.instructions >= -1 &&
+           stats.llc_misses >= -1 && stats.dtlb_misses >= -1 && "Error: Invalid totals");
+  }
+  perf_counters_dump(stdout);
+  printf("Counts per operation - OK\n");
+
+  perf_counters_reset();
+  perf_counters_get(PERF_LIST_INSERT, &stats);
+  assert(stats.calls == 0 && stats.nanoseconds == 0 && "Error: Totals not reset");
+  printf("Reset - OK\n");
+}
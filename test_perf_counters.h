@@ -0,0 +1,6 @@
+#ifndef TEST_PERF_COUNTERS
+#define TEST_PERF_COUNTERS
+
+void test_perf_counters(void);
+
+#endif
@@ -6,8 +6,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <unistd.h>
 #include "queue.h"
 
+static void test_queue_batch(void);
+static void test_queue_save(void);
+static void test_queue_stats(void);
+
 void test_queue(void)
 {
   printf("\n============================");
@@ -46,6 +51,145 @@ void test_queue(void)
   value = 401;
   queue_enqueue(queue, &value);
   
+  assert(queue_size(queue) == 4 && "Error: Incorrect queue size after enqueue");
+
   queue_delete(queue);
   printf("Queue Deleted\n\n");
-}
\ No newline at end of file
+
+  test_queue_batch();
+  test_queue_save();
+  test_queue_stats();
+}
+
+// Drain callback which appends each value to an array
+struct drain_ctx
+{
+  int values[64];
+  int count;
+  queue_p requeue; // if not NULL, each value is enqueued to this queue again
+};
+
+static void drain_value(const void *value, void *ctx)
+{
+  struct drain_ctx *drained = ctx;
+  drained->values[drained->count++] = *(const int *)value;
+  if (drained->requeue)
+    queue_enqueue(drained->requeue, (void *)value);
+}
+
+static void test_queue_batch(void)
+{
+  printf("--- Batch enqueue/dequeue ---\n");
+  queue_p queue = queue_create(sizeof(int));
+  int src[40];
+  int dst[40];
+  int got = -1;
+  for (int i = 0; i < 40; i++)
+    src[i] = i;
+
+  queue_dequeue_n(queue, dst, 10, &got);
+  assert(got == 0 && "Error: Dequeued items from an empty queue");
+
+  int value = -1;
+  queue_enqueue(queue, &value);
+  queue_enqueue_n(queue, src, 30);
+  queue_enqueue_n(queue, src, 0);
+  queue_enqueue_n(queue, src + 30, 10);
+  assert(queue_size(queue) == 41 && "Error: Incorrect queue size after enqueue_n");
+
+  queue_dequeue(queue, &value);
+  assert(value == -1 && "Error: Incorrect value before batch");
+  queue_dequeue_n(queue, dst, 25, &got);
+  assert(got == 25 && "Error: Incorrect number of items dequeued");
+  queue_dequeue_n(queue, dst + 25, 25, &got);
+  assert(got == 15 && "Error: Incorrect number of items dequeued");
+  assert(memcmp(src, dst, sizeof(src)) == 0 && "Error: Incorrect values from dequeue_n");
+  assert(queue_size(queue) == 0 && "Error: Queue not empty after dequeue_n");
+
+  // The queue must still work after being emptied by dequeue_n
+  queue_enqueue_n(queue, src, 3);
+  queue_enqueue(queue, &src[3]);
+  queue_dequeue_n(queue, dst, 40, &got);
+  assert(got == 4 && dst[3] == 3 && "Error: Incorrect values after reuse");
+  printf("Batch enqueue/dequeue - OK\n");
+
+  printf("--- Drain ---\n");
+  struct drain_ctx drained = {.count = 0, .requeue = NULL};
+  assert(queue_drain(queue, drain_value, &drained) == 0 && "Error: Drained items from an empty queue");
+  queue_enqueue_n(queue, src, 20);
+  assert(queue_drain(queue, drain_value, &drained) == 20 && "Error: Incorrect number of items drained");
+  assert(drained.count == 20 && memcmp(drained.values, src, 20 * sizeof(int)) == 0 &&
+         "Error: Incorrect values drained");
+  assert(queue_size(queue) == 0 && "Error: Queue not empty after drain");
+
+  // Items enqueued by the callback are left for the next drain
+  drained.count = 0;
+  drained.requeue = queue;
+  queue_enqueue_n(queue, src, 5);
+  assert(queue_drain(queue, drain_value, &drained) == 5 && "Error: Incorrect number of items drained");
+  assert(queue_size(queue) == 5 && "Error: Requeued items not left in the queue");
+  queue_peek(queue, &value);
+  assert(value == 0 && "Error: Incorrect value at head after requeue");
+  printf("Drain - OK\n");
+
+  queue_delete(queue);
+}
+
+static void test_queue_save(void)
+{
+  printf("--- Save/load ---\n");
+  const char *path = "/tmp/test_queue_save.dsd";
+  queue_p queue = queue_create(sizeof(int));
+  assert(queue_save(queue, path) == 0 && "Error: Cannot save empty queue");
+  queue_p loaded = queue_load(path, sizeof(int));
+  assert(loaded != NULL && queue_size(loaded) == 0 && "Error: Incorrect empty queue after load");
+  queue_delete(loaded);
+
+  // More items than one write batch
+  for (int i = 0; i < 10000; i++)
+    queue_enqueue(queue, &i);
+  assert(queue_save(queue, path) == 0 && "Error: Cannot save queue");
+  assert(queue_load(path, sizeof(long)) == NULL && "Error: Wrong element size accepted");
+
+  loaded = queue_load(path, sizeof(int));
+  assert(loaded != NULL && queue_size(loaded) == 10000 && "Error: Incorrect queue size after load");
+  for (int i = 0; i < 10000; i++)
+  {
+    int value;
+    queue_dequeue(loaded, &value);
+    assert(value == i && "Error: Incorrect value after load");
+  }
+  queue_delete(loaded);
+  queue_delete(queue);
+  unlink(path);
+  printf("Save/load - OK\n");
+}
+
+static void test_queue_stats(void)
+{
+  printf("--- Statistics ---\n");
+  queue_p queue = queue_create(sizeof(int));
+  int values[10] = {0};
+  int got;
+  for (int i = 0; i < 5; i++)
+    queue_enqueue(queue, &i);
+  queue_enqueue_n(queue, values, 10);
+  queue_dequeue(queue, &got);
+  queue_dequeue_n(queue, values, 4, &got);
+  queue_enqueue(queue, &got);
+
+  queue_statistics stats;
+  if (queue_stats(queue, &stats))
+  {
+    assert(stats.enqueues == 16 && stats.dequeues == 5 && "Error: Incorrect enqueues/dequeues");
+    assert(stats.allocations == 16 && stats.frees == 5 && "Error: Incorrect allocations/frees");
+    assert(stats.peak_length == 15 && "Error: Incorrect peak length");
+    printf("Statistics - OK\n");
+  }
+  else
+  {
+    assert(stats.enqueues == 0 && stats.peak_length == 0 && "Error: Statistics without DS_STATS");
+    printf("Statistics not kept (build with STATS=1)\n");
+  }
+  queue_delete(queue);
+}
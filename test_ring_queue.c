@@ -0,0 +1,80 @@
+/**
+ * Basic tests for ring queue data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "ring_queue.h"
+
+void test_ring_queue(void)
+{
+  printf("\n=================================");
+  printf("\n======== Ring Queue Test ========");
+  printf("\n=================================\n\n");
+
+  ring_queue_p queue = ring_queue_create(sizeof(int));
+
+  int value;
+  printf("Enqueue 4 items\n\n");
+  value = 101;
+  ring_queue_enqueue(queue, &value);
+  value = 201;
+  ring_queue_enqueue(queue, &value);
+  value = 301;
+  ring_queue_enqueue(queue, &value);
+  value = 401;
+  ring_queue_enqueue(queue, &value);
+  assert(ring_queue_size(queue) == 4 && "Error: Incorrect queue size after enqueue");
+
+  for (int i = 0; i < 4; i++)
+  {
+    ring_queue_peek(queue, &value);
+    printf("Queue Peek: %d\n", value);
+    assert(value == (i + 1) * 100 + 1 && "Error: Incorrect value at head of queue");
+
+    ring_queue_dequeue(queue, &value);
+    printf("Dequeue item %d: %d\n\n", i + 1, value);
+    assert(value == (i + 1) * 100 + 1 && "Error: Incorrect dequeued value");
+  }
+  assert(ring_queue_size(queue) == 0 && "Error: Incorrect queue size after dequeue");
+
+  printf("Dequeue from empty queue\n");
+  value = -1;
+  ring_queue_dequeue(queue, &value);
+  assert(value == -1 && "Error: Dequeue from empty queue changed out");
+
+  // Move the head part way through the buffer so that the
+  // elements wrap around the end before the buffer grows
+  printf("Enqueue/dequeue ~1000 items with wrap-around\n");
+  for (int i = 0; i < 10; i++)
+  {
+    ring_queue_enqueue(queue, &i);
+    ring_queue_dequeue(queue, &value);
+  }
+  for (int i = 0; i < 1000; i++)
+  {
+    ring_queue_enqueue(queue, &i);
+  }
+  assert(ring_queue_size(queue) == 1000 && "Error: Incorrect queue size after enqueue");
+  for (int i = 0; i < 1000; i++)
+  {
+    ring_queue_dequeue(queue, &value);
+    assert(value == i && "Error: Queue order lost after growing");
+  }
+  printf("Wrap-around test - OK\n");
+
+  printf("Enqueue 4 items\n\n");
+  value = 101;
+  ring_queue_enqueue(queue, &value);
+  value = 201;
+  ring_queue_enqueue(queue, &value);
+  value = 301;
+  ring_queue_enqueue(queue, &value);
+  value = 401;
+  ring_queue_enqueue(queue, &value);
+
+  ring_queue_delete(queue);
+  printf("Queue Deleted\n\n");
+}
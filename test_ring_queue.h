@@ -0,0 +1,7 @@
+
+#ifndef TEST_RING_QUEUE
+#define TEST_RING_QUEUE
+
+void test_ring_queue(void);
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * Basic tests for the scheduler module
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "scheduler.h"
+
+// Cut-off below which the recursive test computes serially
+#define SERIAL_CUTOFF 10
+
+static scheduler_p sched;
+
+struct fib_args
+{
+  int n;
+  long result;
+};
+
+static long fib_serial(int n)
+{
+  return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+// Fork/join: spawn one half, compute the other, then wait
+static void fib_task(void *arg)
+{
+  struct fib_args *args = arg;
+  if (args->n < SERIAL_CUTOFF)
+  {
+    args->result = fib_serial(args->n);
+    return;
+  }
+
+  struct fib_args left = {args->n - 1, 0};
+  struct fib_args right = {args->n - 2, 0};
+  task_group group;
+  task_group_init(&group);
+  scheduler_spawn(sched, &group, fib_task, &left);
+  fib_task(&right);
+  scheduler_wait(sched, &group);
+  args->result = left.result + right.result;
+}
+
+static void count_task(void *arg)
+{
+  atomic_fetch_add((atomic_int *)arg, 1);
+}
+
+void test_scheduler(void)
+{
+  printf("\n================================");
+  printf("\n======== Scheduler Test ========");
+  printf("\n================================\n\n");
+
+  sched = scheduler_create(4);
+  assert(scheduler_workers(sched) == 4 && "Error: Incorrect number of workers");
+
+  printf("Spawn 1000 tasks from outside the pool\n");
+  atomic_int count = 0;
+  task_group group;
+  task_group_init(&group);
+  for (int i = 0; i < 1000; i++)
+    scheduler_spawn(sched, &group, count_task, &count);
+  scheduler_wait(sched, &group);
+  assert(atomic_load(&count) == 1000 && "Error: Not every task ran once");
+  printf("Flat tasks - OK\n");
+
+  printf("Recursive fork/join (fib 25)\n");
+  struct fib_args args = {25, 0};
+  task_group_init(&group);
+  scheduler_spawn(sched, &group, fib_task, &args);
+  scheduler_wait(sched, &group);
+  assert(args.result == fib_serial(25) && "Error: Incorrect fork/join result");
+  printf("Fork/join - OK\n");
+
+  printf("Wait on an empty group\n");
+  task_group_init(&group);
+  scheduler_wait(sched, &group);
+
+  scheduler_delete(sched);
+  printf("Scheduler Deleted\n");
+}
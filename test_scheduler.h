@@ -0,0 +1,6 @@
+#ifndef TEST_SCHEDULER
+#define TEST_SCHEDULER
+
+void test_scheduler(void);
+
+#endif
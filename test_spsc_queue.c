@@ -0,0 +1,78 @@
+/**
+ * Basic tests for spsc queue data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <sched.h>
+#include <pthread.h>
+#include "spsc_queue.h"
+
+// Number of items passed between threads in the two-thread test
+#define NUM_TRANSFERS 100000
+
+static void *producer(void *arg)
+{
+  spsc_queue_p queue = arg;
+  for (int i = 0; i < NUM_TRANSFERS; i++)
+  {
+    while (!spsc_queue_enqueue(queue, &i))
+      sched_yield();
+  }
+  return NULL;
+}
+
+void test_spsc_queue(void)
+{
+  printf("\n=================================");
+  printf("\n======== SPSC Queue Test ========");
+  printf("\n=================================\n\n");
+
+  spsc_queue_p queue = spsc_queue_create(sizeof(int), 3);
+
+  int value;
+  printf("Enqueue 4 items (capacity rounded up to 4)\n");
+  for (int i = 1; i <= 4; i++)
+  {
+    value = i * 100 + 1;
+    assert(spsc_queue_enqueue(queue, &value) && "Error: Enqueue failed on non-full queue");
+  }
+  assert(spsc_queue_size(queue) == 4 && "Error: Incorrect queue size after enqueue");
+  value = 501;
+  assert(!spsc_queue_enqueue(queue, &value) && "Error: Enqueue succeeded on full queue");
+  printf("Full queue rejects enqueue - OK\n\n");
+
+  for (int i = 0; i < 4; i++)
+  {
+    assert(spsc_queue_peek(queue, &value) && "Error: Peek failed on non-empty queue");
+    printf("Queue Peek: %d\n", value);
+    assert(spsc_queue_dequeue(queue, &value) && "Error: Dequeue failed on non-empty queue");
+    printf("Dequeue item %d: %d\n\n", i + 1, value);
+    assert(value == (i + 1) * 100 + 1 && "Error: Incorrect dequeued value");
+  }
+
+  value = -1;
+  assert(!spsc_queue_dequeue(queue, &value) && "Error: Dequeue succeeded on empty queue");
+  assert(value == -1 && "Error: Dequeue from empty queue changed out");
+  printf("Empty queue rejects dequeue - OK\n");
+  spsc_queue_delete(queue);
+
+  printf("Transfer %d items between two threads\n", NUM_TRANSFERS);
+  queue = spsc_queue_create(sizeof(int), 64);
+  pthread_t thread;
+  pthread_create(&thread, NULL, producer, queue);
+  for (int i = 0; i < NUM_TRANSFERS; i++)
+  {
+    while (!spsc_queue_dequeue(queue, &value))
+      sched_yield();
+    assert(value == i && "Error: Items transferred out of order");
+  }
+  pthread_join(thread, NULL);
+  assert(spsc_queue_size(queue) == 0 && "Error: Queue not empty after transfer");
+  printf("Two-thread test - OK\n");
+
+  spsc_queue_delete(queue);
+  printf("Queue Deleted\n\n");
+}
@@ -0,0 +1,7 @@
+
+#ifndef TEST_SPSC_QUEUE
+#define TEST_SPSC_QUEUE
+
+void test_spsc_queue(void);
+
+#endif
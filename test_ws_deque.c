@@ -0,0 +1,95 @@
+/**
+ * Basic tests for ws deque data strucure
+ *
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "ws_deque.h"
+
+// Number of thieves and items in the threaded test
+#define NUM_THIEVES 3
+#define NUM_ITEMS 100000
+
+static ws_deque_p shared_deque;
+static atomic_int taken[NUM_ITEMS];
+static atomic_bool owner_done;
+
+static void *thief(void *arg)
+{
+  (void)arg;
+  int value;
+  while (true)
+  {
+    // Check done before stealing, so an empty deque after done really is final
+    bool done = atomic_load(&owner_done);
+    ws_deque_status status = ws_deque_steal(shared_deque, &value);
+    if (status == WS_DEQUE_OK)
+      atomic_fetch_add(&taken[value], 1);
+    else if (status == WS_DEQUE_EMPTY && done)
+      break;
+  }
+  return NULL;
+}
+
+void test_ws_deque(void)
+{
+  printf("\n===============================");
+  printf("\n======== WS Deque Test ========");
+  printf("\n===============================\n\n");
+
+  ws_deque_p deque = ws_deque_create(sizeof(int), 4);
+  int value = -1;
+
+  printf("Pop and steal from empty deque\n");
+  assert(!ws_deque_pop(deque, &value) && "Error: Popped from empty deque");
+  assert(ws_deque_steal(deque, &value) == WS_DEQUE_EMPTY && "Error: Stole from empty deque");
+  assert(value == -1 && "Error: Pop from empty deque changed out");
+
+  printf("Push 100 items (grows the buffer)\n");
+  for (int i = 0; i < 100; i++)
+    ws_deque_push(deque, &i);
+  assert(ws_deque_size(deque) == 100 && "Error: Incorrect deque size after push");
+
+  printf("Steal takes the oldest, pop the newest\n");
+  assert(ws_deque_steal(deque, &value) == WS_DEQUE_OK && value == 0 && "Error: Incorrect stolen value");
+  assert(ws_deque_pop(deque, &value) && value == 99 && "Error: Incorrect popped value");
+  for (int i = 98; i >= 1; i--)
+  {
+    assert(ws_deque_pop(deque, &value) && value == i && "Error: Incorrect popped value");
+  }
+  assert(ws_deque_size(deque) == 0 && "Error: Deque not empty");
+  assert(!ws_deque_pop(deque, &value) && "Error: Popped from empty deque");
+  printf("Single thread - OK\n");
+
+  printf("Multi-thread test\n");
+  shared_deque = deque;
+  atomic_store(&owner_done, false);
+  pthread_t thieves[NUM_THIEVES];
+  for (int i = 0; i < NUM_THIEVES; i++)
+    pthread_create(&thieves[i], NULL, thief, NULL);
+
+  // The owner pushes everything, popping one item in every four
+  for (int i = 0; i < NUM_ITEMS; i++)
+  {
+    ws_deque_push(deque, &i);
+    if (i % 4 == 3 && ws_deque_pop(deque, &value))
+      atomic_fetch_add(&taken[value], 1);
+  }
+  while (ws_deque_pop(deque, &value))
+    atomic_fetch_add(&taken[value], 1);
+  atomic_store(&owner_done, true);
+
+  for (int i = 0; i < NUM_THIEVES; i++)
+    pthread_join(thieves[i], NULL);
+  for (int i = 0; i < NUM_ITEMS; i++)
+  {
+    assert(atomic_load(&taken[i]) == 1 && "Error: Item lost or taken twice");
+  }
+  printf("Multi-thread test - OK\n");
+
+  ws_deque_delete(deque);
+  printf("Deque Deleted\n");
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_WS_DEQUE
+#define TEST_WS_DEQUE
+
+void test_ws_deque(void);
+
+#endif
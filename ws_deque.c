@@ -0,0 +1,309 @@
+/**
+ * ws_deque.c
+ *
+ * Implementation of functions for the ws_deque module
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ws_deque_p.h"
+
+/*
+The ws deque is the Chase-Lev work-stealing deque, with the memory
+orderings of Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+Work-Stealing for Weak Memory Models" (PPoPP 2013).
+
+top and bottom are free-running indices; the items are at top..bottom-1
+and the slot for an index is (index & (capacity - 1)).
+The owner pushes and pops at bottom, thieves take from top with a CAS.
+When the owner and a thief race for the last item, both use the CAS on
+top, so exactly one of them gets it.
+
+A thief copies the value out before its CAS, so it may copy a slot
+while the owner is writing it; the copy is only used if the CAS shows
+that top had not moved (and so the slot had not been reused).
+
+When the buffer is full, the owner copies the items to a buffer of
+twice the size. The old buffers are kept (chained through previous)
+until the deque is deleted, since a thief may still be reading one.
+*/
+typedef struct _ws_array
+{
+  long capacity; // a power of two
+  struct _ws_array *previous;
+  alignas(max_align_t) char data[];
+} *_ws_array_p;
+
+/*
+The ws deque data type for the ws_deque module
+*/
+typedef struct ws_deque
+{
+  size_t element_size;
+
+  // Taken from by thieves
+  alignas(CACHE_LINE_SIZE) atomic_long top;
+
+  // Owned by the owner thread
+  alignas(CACHE_LINE_SIZE) atomic_long bottom;
+  _Atomic(_ws_array_p) array;
+} *ws_deque_p;
+
+/*
+Creates and initialises a new empty ws deque using the ws_deque_p type
+
+Inputs:
+  element_size - the size of the primitive data type to be stored in the deque
+  capacity - the initial capacity (rounded up to a power of two)
+
+Returns:
+  A ws_deque_p (pointer to the newly created deque)
+
+Throws:
+  aborts if the capacity is not positive or if the memory allocations fail
+
+*/
+ws_deque_p ws_deque_create(size_t element_size, int capacity)
+{
+  assert(capacity > 0 && "Error: Deque capacity must be positive");
+
+  ws_deque_p deque;
+  deque = (ws_deque_p)aligned_alloc(CACHE_LINE_SIZE, sizeof(struct ws_deque));
+  assert(deque != NULL && "Error in memory allocation");
+
+  long rounded = 1;
+  while (rounded < capacity)
+    rounded *= 2;
+
+  deque->element_size = element_size;
+  atomic_init(&deque->top, 0);
+  atomic_init(&deque->bottom, 0);
+  atomic_init(&deque->array, _ws_array_create(element_size, rounded));
+  return deque;
+}
+
+/*
+Push a value at the bottom of the deque (owner only)
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+  value - pointer to a variable containing the value to be pushed
+
+Returns:
+  Nothing
+
+Throws:
+  aborts on memory allocation error
+
+*/
+void ws_deque_push(ws_deque_p deque, const void *value)
+{
+  long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  _ws_array_p array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+  if (bottom - top > array->capacity - 1)
+  {
+    array = _grow_ws_array(deque, array, top, bottom);
+  }
+
+  // The release store publishes the value to thieves (the paper's release
+  // fence and relaxed store, written so that thread sanitizers follow it)
+  memcpy(_ws_slot(array, deque->element_size, bottom), value, deque->element_size);
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+}
+
+/*
+Pop the most recently pushed value from the bottom of the deque (owner only)
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+  out - pointer to a variable to store the value of the popped item
+
+Outputs:
+  out - the value of the popped item (unchanged if the deque is empty)
+
+Returns:
+  True if an item was popped
+  False if the deque was empty
+
+*/
+bool ws_deque_pop(ws_deque_p deque, void *out)
+{
+  long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+  _ws_array_p array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+  atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+  bool popped = false;
+  if (top <= bottom)
+  {
+    popped = true;
+    if (top == bottom)
+    {
+      // The last item: race any thieves for it
+      popped = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                       memory_order_seq_cst,
+                                                       memory_order_relaxed);
+      atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    if (popped)
+      memcpy(out, _ws_slot(array, deque->element_size, bottom), deque->element_size);
+  }
+  else
+  {
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+  }
+  return popped;
+}
+
+/*
+Steal the oldest value from the top of the deque (any thread)
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+  out - pointer to a variable to store the value of the stolen item
+
+Outputs:
+  out - the value of the stolen item (unspecified unless WS_DEQUE_OK is returned)
+
+Returns:
+  WS_DEQUE_OK if an item was stolen
+  WS_DEQUE_EMPTY if the deque was empty
+  WS_DEQUE_ABORT if another thread took the item first
+
+*/
+ws_deque_status ws_deque_steal(ws_deque_p deque, void *out)
+{
+  long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+  if (top >= bottom)
+    return WS_DEQUE_EMPTY;
+
+  _ws_array_p array = atomic_load_explicit(&deque->array, memory_order_acquire);
+  memcpy(out, _ws_slot(array, deque->element_size, top), deque->element_size);
+  if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                               memory_order_seq_cst,
+                                               memory_order_relaxed))
+    return WS_DEQUE_ABORT;
+  return WS_DEQUE_OK;
+}
+
+/*
+Get the number of items in the deque
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+
+Returns:
+  The number of items in the deque (a snapshot if other threads are using it)
+
+*/
+int ws_deque_size(ws_deque_p deque)
+{
+  long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+  return bottom > top ? (int)(bottom - top) : 0;
+}
+
+/*
+Frees the memory allocated to deque (and all of its buffers)
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+
+Returns:
+  Nothing
+
+*/
+void ws_deque_delete(ws_deque_p deque)
+{
+  if (deque)
+  {
+    _ws_array_p array = atomic_load(&deque->array);
+    while (array)
+    {
+      _ws_array_p previous = array->previous;
+      free(array);
+      array = previous;
+    }
+    free(deque);
+  }
+}
+
+/*
+Internal function to allocate a buffer
+
+Inputs:
+  element_size - the size of the primitive data type stored in the deque
+  capacity - the number of slots (a power of two)
+
+Returns:
+  A pointer to the new buffer
+
+Throws:
+  aborts if the memory allocation fails
+
+*/
+_ws_array_p _ws_array_create(size_t element_size, long capacity)
+{
+  _ws_array_p array = (_ws_array_p)malloc(sizeof(struct _ws_array) + capacity * element_size);
+  assert(array != NULL && "Error in memory allocation");
+
+  array->capacity = capacity;
+  array->previous = NULL;
+  return array;
+}
+
+/*
+Internal function to replace the buffer with one of twice the size
+(owner only). The old buffer is kept until the deque is deleted
+
+Inputs:
+  deque - pointer to an instance of the ws deque type
+  array - the current buffer
+  top - the top index
+  bottom - the bottom index
+
+Returns:
+  A pointer to the new buffer
+
+*/
+_ws_array_p _grow_ws_array(ws_deque_p deque, _ws_array_p array, long top, long bottom)
+{
+  _ws_array_p grown = _ws_array_create(deque->element_size, array->capacity * 2);
+  grown->previous = array;
+  for (long i = top; i < bottom; i++)
+  {
+    memcpy(_ws_slot(grown, deque->element_size, i), _ws_slot(array, deque->element_size, i),
+           deque->element_size);
+  }
+  atomic_store_explicit(&deque->array, grown, memory_order_release);
+  return grown;
+}
+
+/*
+Internal function to get the slot for an index
+
+Inputs:
+  array - the buffer
+  element_size - the size of the primitive data type stored in the deque
+  index - the (free-running) index
+
+Returns:
+  A pointer to the slot
+
+*/
+char *_ws_slot(_ws_array_p array, size_t element_size, long index)
+{
+  return array->data + (size_t)(index & (array->capacity - 1)) * element_size;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file ws_deque.h
+ * @brief Public function prototypes for the ws_deque module
+ *
+ * Function prototypes required to use the ws_deque module.
+ * The ws deque is a lock-free work-stealing deque (Chase-Lev): one owner
+ * thread pushes and pops at the bottom, while any number of other
+ * threads (thieves) steal from the top. The buffer grows as needed.
+ * As for the queue module, values are copied in and out of the deque
+ * (element_size bytes at a time).
+ *
+ * ws_deque_push and ws_deque_pop may only be called by the owner thread.
+ *
+ * @author ruairin
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifndef WS_DEQUE
+#define WS_DEQUE
+
+/**
+ * @brief Data type represeting the ws deque
+ */
+typedef struct ws_deque *ws_deque_p;
+
+/**
+ * @brief Return codes for ws_deque_steal
+ */
+typedef enum ws_deque_status
+{
+  WS_DEQUE_OK = 0, // an item was stolen
+  WS_DEQUE_EMPTY,  // the deque was empty
+  WS_DEQUE_ABORT   // another thread took the item first (the deque may not be empty)
+} ws_deque_status;
+
+/**
+ * @brief create and initialise a new ws deque
+ *
+ * Example usage to create a deque of ints:
+ * ws_deque_p my_deque;
+ * my_deque = ws_deque_create(sizeof(int), 256);
+ *
+ * @param[in] element_size The size of the data type to be stored in the deque
+ * @param[in] capacity The initial capacity (rounded up to a power of two)
+ * @return A ws_deque_p (i.e. pointer to the deque data type) to the created deque
+ */
+ws_deque_p ws_deque_create(size_t element_size, int capacity);
+
+/**
+ * @brief add a new value at the bottom of the deque (owner only)
+ *
+ * @param[in] deque A pointer to an instance of the ws_deque_p data type
+ * @param[in] value pointer to a variable storing the value to be added
+ * @return nothing
+ */
+void ws_deque_push(ws_deque_p deque, const void *value);
+
+/**
+ * @brief Remove the most recently pushed value from the bottom of the deque (owner only)
+ *
+ * @param[in] deque A pointer to an instance of the ws_deque_p data type
+ * @param[inout] out pointer to a variable containing the value that was removed
+ * @return true if a value was removed, false if the deque was empty
+ *         (out is unchanged)
+ */
+bool ws_deque_pop(ws_deque_p deque, void *out);
+
+/**
+ * @brief Remove the oldest value from the top of the deque (any thread)
+ *
+ * @param[in] deque A pointer to an instance of the ws_deque_p data type
+ * @param[inout] out pointer to a variable containing the value that was stolen
+ *                   (its contents are unspecified unless WS_DEQUE_OK is returned)
+ * @return WS_DEQUE_OK, WS_DEQUE_EMPTY or WS_DEQUE_ABORT
+ */
+ws_deque_status ws_deque_steal(ws_deque_p deque, void *out);
+
+/**
+ * @brief Get the number of items in the deque
+ *
+ * With other threads using the deque, the result is only a snapshot.
+ *
+ * @param[in] deque A pointer to an instance of the ws_deque_p data type
+ * @return The number of items in the deque
+ */
+int ws_deque_size(ws_deque_p deque);
+
+/**
+ * @brief Delete the deque and deallocate memory
+ *
+ * No thread may be using the deque.
+ *
+ * @param[in] deque A pointer to an instance of the ws_deque_p data type
+ * @return nothing
+ */
+void ws_deque_delete(ws_deque_p deque);
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * ws_deque_p.h
+ *
+ * Private header file for ws_deque module
+ *
+ * @author ruairin
+ *
+ */
+
+#include <stdlib.h>
+#include "ws_deque.h"
+
+#ifndef WS_DEQUE_P
+#define WS_DEQUE_P
+
+// Assumed size of a cache line.
+// The top and bottom indices are placed on separate cache lines
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Data type representing a circular buffer of the deque
+ */
+typedef struct _ws_array *_ws_array_p;
+
+_ws_array_p _ws_array_create(size_t element_size, long capacity);
+_ws_array_p _grow_ws_array(ws_deque_p deque, _ws_array_p array, long top, long bottom);
+char *_ws_slot(_ws_array_p array, size_t element_size, long index);
+
+#endif